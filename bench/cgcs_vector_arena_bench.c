@@ -0,0 +1,117 @@
+/*!
+    \file       cgcs_vector_arena_bench.c
+    \brief      Benchmark: malloc-backed vector_init vs. vector_arena_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector.h"
+#include "cgcs_vector_arena.h"
+#include "cgcs_vector_bench.h"
+
+#include <stdio.h>
+#include <time.h>
+
+// Simulates a request handler that builds VECTORS_PER_REQUEST vectors,
+// fills each with ELEMENTS_PER_VECTOR pointers, and tears them all down.
+#define REQUESTS 20000
+#define VECTORS_PER_REQUEST 32
+#define ELEMENTS_PER_VECTOR 48
+#define INITIAL_CAPACITY 4
+
+double bench_malloc(void);
+double bench_arena(void);
+
+bool arena_zero_capacity_ok(void);
+
+int main(int argc, const char *argv[]) {
+    printf("%d requests x %d vectors x %d elements (initial capacity %d)\n\n",
+           REQUESTS, VECTORS_PER_REQUEST, ELEMENTS_PER_VECTOR, INITIAL_CAPACITY);
+
+    printf("%-28s %10.2f ms\n", "vector_init/vector_deinit", bench_malloc());
+    printf("%-28s %10.2f ms\n", "vector_arena_t", bench_arena());
+
+    if (!arena_zero_capacity_ok()) {
+        printf("\nvector_arena_t: zero-capacity vector aliased its neighbour\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+double bench_malloc(void) {
+    vector_t vecs[VECTORS_PER_REQUEST];
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    for (int r = 0; r < REQUESTS; r++) {
+        for (int v = 0; v < VECTORS_PER_REQUEST; v++) {
+            vector_init(&vecs[v], INITIAL_CAPACITY);
+
+            for (int e = 0; e < ELEMENTS_PER_VECTOR; e++) {
+                void *ptr = &vecs[v];
+                vector_push_back(&vecs[v], &ptr);
+            }
+        }
+
+        for (int v = 0; v < VECTORS_PER_REQUEST; v++) {
+            vector_deinit(&vecs[v]);
+        }
+    }
+
+    return elapsed_ms(&start);
+}
+
+double bench_arena(void) {
+    vector_t vecs[VECTORS_PER_REQUEST];
+    vector_arena_t arena;
+    struct timespec start;
+
+    vector_arena_init(&arena, 64 * 1024);
+    timespec_get(&start, TIME_UTC);
+
+    for (int r = 0; r < REQUESTS; r++) {
+        for (int v = 0; v < VECTORS_PER_REQUEST; v++) {
+            vector_init_allocator(&vecs[v], INITIAL_CAPACITY, vector_arena_allocator(&arena));
+
+            for (int e = 0; e < ELEMENTS_PER_VECTOR; e++) {
+                void *ptr = &vecs[v];
+                vector_push_back(&vecs[v], &ptr);
+            }
+        }
+
+        // One reset instead of VECTORS_PER_REQUEST calls to vector_deinit.
+        vector_arena_reset(&arena);
+    }
+
+    const double ms = elapsed_ms(&start);
+    vector_arena_deinit(&arena);
+
+    return ms;
+}
+
+// Regression: a zero-capacity vector must not share its block with the
+// vector allocated after it, or growing it in place would overwrite it.
+bool arena_zero_capacity_ok(void) {
+    vector_t a, b;
+    vector_arena_t arena;
+    void *sentinel = &b;
+    void *other = &a;
+    bool ok = true;
+
+    vector_arena_init(&arena, 4096);
+
+    vector_init_allocator(&a, 0, vector_arena_allocator(&arena));
+    vector_init_allocator(&b, 4, vector_arena_allocator(&arena));
+
+    vector_push_back(&b, &sentinel);
+    vector_push_back(&a, &other);
+
+    ok = ok && a.m_impl.m_start != b.m_impl.m_start;
+    ok = ok && *(void **)vector_front(&b) == sentinel;
+    ok = ok && *(void **)vector_front(&a) == other;
+
+    vector_arena_deinit(&arena);
+    return ok;
+}
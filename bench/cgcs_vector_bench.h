@@ -0,0 +1,30 @@
+/*!
+    \file       cgcs_vector_bench.h
+    \brief      Header file for helpers shared by the cgcs_vector benchmarks
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_BENCH_H
+#define CGCS_VECTOR_BENCH_H
+
+#include <time.h>
+
+static double elapsed_ms(struct timespec *start);
+
+/*!
+    \brief      Returns the milliseconds since start (from timespec_get)
+
+    \param[in]  start
+
+    \return
+*/
+static inline double elapsed_ms(struct timespec *start) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+
+    return (now.tv_sec - start->tv_sec) * 1e3 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+#endif /* CGCS_VECTOR_BENCH_H */
@@ -0,0 +1,72 @@
+/*!
+    \file       cgcs_vector_cache_bench.c
+    \brief      Benchmark: short-lived temporary vectors with vector_init
+                vs. vector_init_cached
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_cache.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define ROUNDS (1 << 18)
+
+uintptr_t churn(void (*initfn)(vector_t *, size_t), size_t capacity, size_t length);
+
+int main(int argc, const char *argv[]) {
+    const size_t capacities[] = { 16, 256, 4096, 32768 };
+
+    printf("%d rounds of init, push_back x 8, clear, push_back x 8, deinit (ms)\n\n", ROUNDS);
+    printf("%10s %14s %20s\n", "capacity", "vector_init", "vector_init_cached");
+
+    for (size_t k = 0; k < sizeof capacities / sizeof *capacities; k++) {
+        struct timespec start;
+        double plain_ms, cached_ms;
+        uintptr_t check = 0;
+
+        timespec_get(&start, TIME_UTC);
+        check += churn(vector_init, capacities[k], 8);
+        plain_ms = elapsed_ms(&start);
+
+        timespec_get(&start, TIME_UTC);
+        check += churn(vector_init_cached, capacities[k], 8);
+        cached_ms = elapsed_ms(&start);
+
+        printf("%10zu %14.2f %20.2f   (%lu)\n", capacities[k], plain_ms, cached_ms,
+               (unsigned long)check);
+    }
+
+    vector_cache_trim();
+    return EXIT_SUCCESS;
+}
+
+uintptr_t churn(void (*initfn)(vector_t *, size_t), size_t capacity, size_t length) {
+    uintptr_t check = 0;
+
+    for (size_t r = 0; r < ROUNDS; r++) {
+        vector_t v;
+
+        initfn(&v, capacity);
+
+        for (uintptr_t i = 0; i < length; i++) {
+            void *value = (void *)(r + i);
+            vector_push_back(&v, &value);
+        }
+
+        vector_clear(&v);
+
+        for (uintptr_t i = 0; i < length; i++) {
+            void *value = (void *)(r ^ i);
+            vector_push_back(&v, &value);
+        }
+
+        check += (uintptr_t)*(void **)vector_back(&v);
+        vector_deinit(&v);
+    }
+
+    return check;
+}
@@ -0,0 +1,106 @@
+/*!
+    \file       cgcs_vector_concurrent_bench.c
+    \brief      Benchmark: vector_push_back under a mutex
+                vs. vector_concurrent_push_back
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_concurrent.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define PER_THREAD 1000000
+#define MAX_THREADS 8
+
+struct producer {
+    size_t id;
+    size_t batch;
+};
+
+vector_t locked;
+pthread_mutex_t locked_mutex = PTHREAD_MUTEX_INITIALIZER;
+vector_concurrent_t concurrent;
+
+void *produce_locked(void *arg);
+void *produce_concurrent(void *arg);
+
+double bench(void *(*produce)(void *), size_t nthreads, size_t batch);
+
+int main(int argc, const char *argv[]) {
+    printf("%d blocks appended per thread (ms)\n\n", PER_THREAD);
+    printf("%-8s %12s %20s %20s\n", "threads", "mutex", "concurrent (1)", "concurrent (64)");
+
+    for (size_t nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2) {
+        double locked_ms, concurrent_ms, batched_ms;
+
+        vector_init(&locked, 16);
+        locked_ms = bench(produce_locked, nthreads, 1);
+        vector_deinit(&locked);
+
+        vector_concurrent_init(&concurrent, 16);
+        concurrent_ms = bench(produce_concurrent, nthreads, 1);
+        vector_concurrent_deinit(&concurrent);
+
+        vector_concurrent_init(&concurrent, 16);
+        batched_ms = bench(produce_concurrent, nthreads, 64);
+        vector_concurrent_deinit(&concurrent);
+
+        printf("%-8zu %12.2f %20.2f %20.2f\n", nthreads, locked_ms, concurrent_ms, batched_ms);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void *produce_locked(void *arg) {
+    struct producer *producer = arg;
+
+    for (size_t i = 0; i < PER_THREAD; i++) {
+        void *value = (void *)(producer->id * PER_THREAD + i);
+
+        pthread_mutex_lock(&locked_mutex);
+        vector_push_back(&locked, &value);
+        pthread_mutex_unlock(&locked_mutex);
+    }
+
+    return NULL;
+}
+
+void *produce_concurrent(void *arg) {
+    struct producer *producer = arg;
+    void *batch[64];
+
+    for (size_t i = 0; i < PER_THREAD; i += producer->batch) {
+        for (size_t j = 0; j < producer->batch; j++) {
+            batch[j] = (void *)(producer->id * PER_THREAD + i + j);
+        }
+
+        vector_concurrent_append_n(&concurrent, batch, producer->batch);
+    }
+
+    return NULL;
+}
+
+double bench(void *(*produce)(void *), size_t nthreads, size_t batch) {
+    pthread_t threads[MAX_THREADS];
+    struct producer producers[MAX_THREADS];
+    struct timespec start;
+
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t t = 0; t < nthreads; t++) {
+        producers[t].id = t;
+        producers[t].batch = batch;
+        pthread_create(&threads[t], NULL, produce, &producers[t]);
+    }
+
+    for (size_t t = 0; t < nthreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    return elapsed_ms(&start);
+}
@@ -0,0 +1,118 @@
+/*!
+    \file       cgcs_vector_gap_bench.c
+    \brief      Benchmark: edits around a moving cursor with vector_insert
+                and vector_erase vs. vector_gap_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_gap.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LENGTH (1 << 20)
+#define EDITS (1 << 16)
+
+size_t gap_erase_moves(size_t cursor, size_t pos, size_t n);
+
+int main(int argc, const char *argv[]) {
+    struct timespec start;
+    double vector_ms, gap_ms;
+    size_t cursor = LENGTH / 4;
+    vector_t v;
+    vector_gap_t g;
+
+    vector_init_elem(&v, LENGTH + EDITS, sizeof(char));
+    vector_gap_init_elem(&g, LENGTH + EDITS, sizeof(char));
+
+    for (size_t i = 0; i < LENGTH; i++) {
+        const char c = 'a' + i % 26;
+
+        vector_push_back(&v, &c);
+        vector_gap_push_back(&g, &c);
+    }
+
+    // Type a character, now and then backspace or jump a few lines.
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < EDITS; i++) {
+        const char c = 'A' + i % 26;
+
+        if (i % 64 == 63) {
+            cursor = (cursor + 640) % vector_size(&v);
+        } else if (i % 8 == 7 && cursor > 0) {
+            vector_erase(&v, vector_advance(&v, vector_begin(&v), --cursor));
+        } else {
+            vector_insert(&v, vector_advance(&v, vector_begin(&v), cursor++), &c);
+        }
+    }
+
+    vector_ms = elapsed_ms(&start);
+
+    cursor = LENGTH / 4;
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < EDITS; i++) {
+        const char c = 'A' + i % 26;
+
+        if (i % 64 == 63) {
+            cursor = (cursor + 640) % vector_gap_size(&g);
+        } else if (i % 8 == 7 && cursor > 0) {
+            vector_gap_erase(&g, --cursor);
+        } else {
+            vector_gap_insert(&g, cursor++, &c);
+        }
+    }
+
+    gap_ms = elapsed_ms(&start);
+
+    printf("%d edits around a cursor in %d chars (ms)\n\n", EDITS, LENGTH);
+    printf("%-28s %10.2f\n", "vector_insert/vector_erase", vector_ms);
+    printf("%-28s %10.2f\n", "vector_gap_t", gap_ms);
+
+    // An erase straddling the gap must move only the blocks on its nearer side.
+    if (gap_erase_moves(10, 9, 10) != 1 || gap_erase_moves(10, 1, 10) != 1) {
+        printf("\nvector_gap_erase_n: moved the gap to the far end of the range\n");
+        return EXIT_FAILURE;
+    }
+
+    vector_gap_deinit(&g);
+    vector_deinit(&v);
+
+    return EXIT_SUCCESS;
+}
+
+// Returns how many blocks vector_gap_erase_n(pos, n) copies, with the gap
+// at cursor, by counting the slots of the old gap it wrote blocks into.
+size_t gap_erase_moves(size_t cursor, size_t pos, size_t n) {
+    const char sentinel = '#';
+    size_t gap_begin, gap_end, moved = 0;
+    vector_gap_t g;
+
+    vector_gap_init_elem(&g, 128, sizeof(char));
+
+    for (size_t i = 0; i < 64; i++) {
+        const char c = 'a' + i % 26;
+        vector_gap_push_back(&g, &c);
+    }
+
+    vector_gap_move(&g, cursor);
+    gap_begin = g.m_gap_begin;
+    gap_end = g.m_gap_end;
+
+    char *slots = (char *)g.m_impl.m_start;
+    memset(slots + gap_begin, sentinel, gap_end - gap_begin);
+
+    vector_gap_erase_n(&g, pos, n);
+
+    for (size_t i = gap_begin; i < gap_end; i++) {
+        moved += slots[i] != sentinel;
+    }
+
+    vector_gap_deinit(&g);
+    return moved;
+}
@@ -0,0 +1,91 @@
+/*!
+    \file       cgcs_vector_image_bench.c
+    \brief      Benchmark: starting up from a vector image with read(2)
+                vs. vector_map
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_image.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LENGTH (1 << 24)
+#define LOOKUPS (1 << 10)
+
+int main(int argc, const char *argv[]) {
+    char path[] = "/tmp/cgcs_vector_image_benchXXXXXX";
+    struct timespec start;
+    double save_ms, read_ms, map_ms, lookup_ms;
+    uint64_t sum = 0;
+    vector_t v, loaded, mapped;
+    int fd = mkstemp(path);
+
+    if (fd < 0) {
+        perror("mkstemp");
+        return EXIT_FAILURE;
+    }
+
+    vector_init_elem(&v, LENGTH, sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < LENGTH; i++) {
+        vector_push_back(&v, &i);
+    }
+
+    timespec_get(&start, TIME_UTC);
+    vector_save(&v, fd, NULL);
+    save_ms = elapsed_ms(&start);
+    close(fd);
+
+    // Reading the blocks into a fresh vector: the cost grows with the image.
+    timespec_get(&start, TIME_UTC);
+    fd = open(path, O_RDONLY);
+    lseek(fd, 4096, SEEK_SET);
+    vector_init_elem(&loaded, LENGTH, sizeof(uint64_t));
+    vector_resize(&loaded, LENGTH);
+
+    for (size_t done = 0; done < sizeof(uint64_t) * LENGTH;) {
+        const ssize_t n = read(fd, (char *)vector_begin(&loaded) + done,
+                               sizeof(uint64_t) * LENGTH - done);
+
+        if (n <= 0) {
+            break;
+        }
+
+        done += (size_t)n;
+    }
+
+    close(fd);
+    read_ms = elapsed_ms(&start);
+
+    // Mapping it: the cost does not.
+    timespec_get(&start, TIME_UTC);
+    vector_map(&mapped, path);
+    map_ms = elapsed_ms(&start);
+
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        sum += *(uint64_t *)vector_i(&mapped, (i * 2654435761u) % LENGTH);
+    }
+
+    lookup_ms = elapsed_ms(&start);
+
+    printf("%d blocks of uint64_t (ms; checksum %llu)\n\n", LENGTH, (unsigned long long)sum);
+    printf("%-32s %10.2f\n", "vector_save", save_ms);
+    printf("%-32s %10.2f\n", "read into a vector_t", read_ms);
+    printf("%-32s %10.2f\n", "vector_map", map_ms);
+    printf("%-32s %10.2f\n", "first lookups (vector_map)", lookup_ms);
+
+    vector_deinit(&mapped);
+    vector_deinit(&loaded);
+    vector_deinit(&v);
+    unlink(path);
+
+    return EXIT_SUCCESS;
+}
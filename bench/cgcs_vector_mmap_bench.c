@@ -0,0 +1,74 @@
+/*!
+    \file       cgcs_vector_mmap_bench.c
+    \brief      Benchmark: growing a huge vector_t with malloc
+                vs. vector_mmap_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_mmap.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define LENGTH (1 << 25)
+
+void bench(const char *name, const vector_allocator_t *alloc);
+
+int main(int argc, const char *argv[]) {
+    vector_mmap_t mapped, reserved, huge;
+
+    vector_mmap_init(&mapped, 0, CGCS_VECTOR_MMAP_DEFAULT);
+    vector_mmap_init(&reserved, sizeof(voidptr) * LENGTH, CGCS_VECTOR_MMAP_DEFAULT);
+    vector_mmap_init(&huge, sizeof(voidptr) * LENGTH, CGCS_VECTOR_MMAP_HUGEPAGES);
+
+    printf("%d pointers pushed onto a vector of capacity 16 (ms)\n\n", LENGTH);
+    printf("%-28s %12s %14s %16s\n", "", "push_back", "worst growth", "shrink_to_fit");
+
+    bench("malloc", &cgcs_vector_malloc_allocator);
+    bench("vector_mmap_t", vector_mmap_allocator(&mapped));
+    bench("vector_mmap_t (reserved)", vector_mmap_allocator(&reserved));
+    bench("vector_mmap_t (huge pages)", vector_mmap_allocator(&huge));
+
+    return EXIT_SUCCESS;
+}
+
+void bench(const char *name, const vector_allocator_t *alloc) {
+    struct timespec start;
+    double push_ms, worst_ms = 0, shrink_ms;
+    vector_t v;
+
+    vector_init_allocator(&v, 16, alloc);
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < LENGTH; i++) {
+        void *value = (void *)i;
+
+        if (vector_size(&v) == vector_capacity(&v)) {
+            struct timespec grow;
+            double ms;
+
+            timespec_get(&grow, TIME_UTC);
+            vector_push_back(&v, &value);
+            ms = elapsed_ms(&grow);
+            worst_ms = ms > worst_ms ? ms : worst_ms;
+        } else {
+            vector_push_back(&v, &value);
+        }
+    }
+
+    push_ms = elapsed_ms(&start);
+
+    while (vector_size(&v) > LENGTH / 4) {
+        vector_pop_back(&v);
+    }
+
+    timespec_get(&start, TIME_UTC);
+    vector_shrink_to_fit(&v);
+    shrink_ms = elapsed_ms(&start);
+
+    printf("%-28s %12.2f %14.2f %16.2f\n", name, push_ms, worst_ms, shrink_ms);
+    vector_deinit(&v);
+}
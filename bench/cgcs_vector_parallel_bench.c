@@ -0,0 +1,103 @@
+/*!
+    \file       cgcs_vector_parallel_bench.c
+    \brief      Benchmark: vector_parallel_*sort* scaling by thread count
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_parallel.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LENGTH 4000000
+
+int long_compare(const void *a, const void *b);
+void fill(vector_t *v, long *values);
+
+double bench_sort(vector_t *v, void (*sort)(vector_t *, int (*)(const void *, const void *)));
+double bench_parallel_sort(vector_t *v,
+                           void (*sort)(vector_t *, int (*)(const void *, const void *), size_t),
+                           size_t nthreads);
+
+int main(int argc, const char *argv[]) {
+    const size_t ncpus = cgcs_vector_parallel_nthreads(0);
+    long *values = malloc(sizeof *values * LENGTH);
+    double qsort_ms, mergesort_ms;
+    vector_t v;
+
+    vector_init(&v, LENGTH);
+
+    printf("%d pointers to random long, %zu CPUs online\n\n", LENGTH, ncpus);
+
+    fill(&v, values);
+    qsort_ms = bench_sort(&v, vector_qsort);
+
+    fill(&v, values);
+    mergesort_ms = bench_sort(&v, vector_mergesort);
+
+    printf("%-8s %20s %25s\n", "threads", "vector_parallel_sort", "vector_parallel_mergesort");
+    printf("%-8s %17.2f ms %22.2f ms  (vector_qsort, vector_mergesort)\n",
+           "serial", qsort_ms, mergesort_ms);
+
+    for (size_t nthreads = 1; nthreads <= ncpus * 2; nthreads *= 2) {
+        double sort_ms, parallel_mergesort_ms;
+
+        fill(&v, values);
+        sort_ms = bench_parallel_sort(&v, vector_parallel_sort, nthreads);
+
+        fill(&v, values);
+        parallel_mergesort_ms = bench_parallel_sort(&v, vector_parallel_mergesort, nthreads);
+
+        printf("%-8zu %17.2f ms %22.2f ms  (x%.2f, x%.2f)\n",
+               nthreads, sort_ms, parallel_mergesort_ms,
+               qsort_ms / sort_ms, mergesort_ms / parallel_mergesort_ms);
+    }
+
+    vector_deinit(&v);
+    free(values);
+
+    return EXIT_SUCCESS;
+}
+
+int long_compare(const void *a, const void *b) {
+    const long lhs = **(long **)(a);
+    const long rhs = **(long **)(b);
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+void fill(vector_t *v, long *values) {
+    unsigned long state = 12345;
+
+    vector_clear(v);
+
+    for (long i = 0; i < LENGTH; i++) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        values[i] = (long)(state >> 33);
+
+        long *ptr = &values[i];
+        vector_push_back(v, &ptr);
+    }
+}
+
+double bench_sort(vector_t *v, void (*sort)(vector_t *, int (*)(const void *, const void *))) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    sort(v, long_compare);
+    return elapsed_ms(&start);
+}
+
+double bench_parallel_sort(vector_t *v,
+                           void (*sort)(vector_t *, int (*)(const void *, const void *), size_t),
+                           size_t nthreads) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    sort(v, long_compare, nthreads);
+    return elapsed_ms(&start);
+}
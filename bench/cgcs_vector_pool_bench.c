@@ -0,0 +1,135 @@
+/*!
+    \file       cgcs_vector_pool_bench.c
+    \brief      Benchmark: vector_foreach_parallel on the pool
+                vs. creating threads per call
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_parallel.h"
+#include "cgcs_vector_pool.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define ROUNDS 200
+
+struct slice {
+    vector_t *v;
+    size_t first;
+    size_t last;
+};
+
+void long_scramble(void *arg);
+void *slice_run(void *arg);
+void foreach_thread_per_call(vector_t *v, size_t nthreads);
+
+double bench_serial(vector_t *v);
+double bench_thread_per_call(vector_t *v, size_t nthreads);
+double bench_pool(vector_t *v);
+
+int main(int argc, const char *argv[]) {
+    const size_t nthreads = vector_pool_nthreads();
+
+    printf("vector_foreach over n pointers to long, %d rounds, %zu threads (ms per round)\n\n",
+           ROUNDS, nthreads);
+    printf("%-9s %10s %16s %10s\n", "n", "serial", "thread per call", "pool");
+
+    for (size_t n = 1000; n <= 1000000; n *= 10) {
+        long *values = calloc(n, sizeof *values);
+        vector_t v;
+
+        vector_init(&v, n);
+
+        for (size_t i = 0; i < n; i++) {
+            long *ptr = &values[i];
+            vector_push_back(&v, &ptr);
+        }
+
+        printf("%-9zu %10.4f %16.4f %10.4f\n", n,
+               bench_serial(&v), bench_thread_per_call(&v, nthreads), bench_pool(&v));
+
+        vector_deinit(&v);
+        free(values);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// Kept out of line, so every variant pays the same call per element.
+__attribute__((noinline)) void long_scramble(void *arg) {
+    long *value = *(long **)(arg);
+    *value = *value * 6364136223846793005L + 1442695040888963407L;
+}
+
+void *slice_run(void *arg) {
+    struct slice *slice = arg;
+
+    vector_foreach_range(slice->v, long_scramble,
+                         vector_advance(slice->v, vector_begin(slice->v), slice->first),
+                         vector_advance(slice->v, vector_begin(slice->v), slice->last));
+    return NULL;
+}
+
+// What every parallel algorithm did before the pool: one thread per slice, per call.
+void foreach_thread_per_call(vector_t *v, size_t nthreads) {
+    pthread_t *threads = malloc(sizeof *threads * nthreads);
+    struct slice *slices = malloc(sizeof *slices * nthreads);
+    const size_t n = vector_size(v);
+
+    for (size_t i = 0; i < nthreads; i++) {
+        slices[i].v = v;
+        slices[i].first = n * i / nthreads;
+        slices[i].last = n * (i + 1) / nthreads;
+
+        if (i > 0) {
+            pthread_create(&threads[i], NULL, slice_run, &slices[i]);
+        }
+    }
+
+    slice_run(&slices[0]);
+
+    for (size_t i = 1; i < nthreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(slices);
+    free(threads);
+}
+
+double bench_serial(vector_t *v) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    for (int r = 0; r < ROUNDS; r++) {
+        vector_foreach(v, long_scramble);
+    }
+
+    return elapsed_ms(&start) / ROUNDS;
+}
+
+double bench_thread_per_call(vector_t *v, size_t nthreads) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    for (int r = 0; r < ROUNDS; r++) {
+        foreach_thread_per_call(v, nthreads);
+    }
+
+    return elapsed_ms(&start) / ROUNDS;
+}
+
+double bench_pool(vector_t *v) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    for (int r = 0; r < ROUNDS; r++) {
+        vector_foreach_parallel(v, long_scramble, NULL);
+    }
+
+    return elapsed_ms(&start) / ROUNDS;
+}
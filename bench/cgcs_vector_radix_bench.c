@@ -0,0 +1,132 @@
+/*!
+    \file       cgcs_vector_radix_bench.c
+    \brief      Benchmark: comparison sorts vs. vector_radix_sort_by_key
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_parallel.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LENGTH 1000000
+
+struct event {
+    uint64_t timestamp;
+    char payload[24];
+};
+
+enum pattern { RANDOM, SORTED, NARROW, PATTERN_COUNT };
+
+const char *pattern_names[] = { "random", "sorted", "narrow" };
+
+int event_compare(const void *a, const void *b);
+uint64_t event_key(const void *arg);
+void fill(vector_t *v, struct event *events, enum pattern pattern);
+
+double bench_sort(vector_t *v, void (*sort)(vector_t *, int (*)(const void *, const void *)));
+double bench_radix_sort(vector_t *v);
+double bench_parallel_radix_sort(vector_t *v);
+
+int main(int argc, const char *argv[]) {
+    struct event *events = malloc(sizeof *events * LENGTH);
+    vector_t v;
+
+    vector_init(&v, LENGTH);
+
+    printf("%d pointers to struct event, sorted by 64-bit timestamp, %zu CPUs online\n\n",
+           LENGTH, cgcs_vector_parallel_nthreads(0));
+    printf("%-8s %14s %18s %17s %18s\n",
+           "", "vector_qsort", "vector_mergesort", "vector_radix_*", "vector_parallel_*");
+
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+        double qsort_ms, mergesort_ms, radix_ms, parallel_radix_ms;
+
+        fill(&v, events, p);
+        qsort_ms = bench_sort(&v, vector_qsort);
+
+        fill(&v, events, p);
+        mergesort_ms = bench_sort(&v, vector_mergesort);
+
+        fill(&v, events, p);
+        radix_ms = bench_radix_sort(&v);
+
+        fill(&v, events, p);
+        parallel_radix_ms = bench_parallel_radix_sort(&v);
+
+        printf("%-8s %11.2f ms %15.2f ms %14.2f ms %15.2f ms\n",
+               pattern_names[p], qsort_ms, mergesort_ms, radix_ms, parallel_radix_ms);
+    }
+
+    vector_deinit(&v);
+    free(events);
+
+    return EXIT_SUCCESS;
+}
+
+int event_compare(const void *a, const void *b) {
+    const uint64_t lhs = (*(struct event **)(a))->timestamp;
+    const uint64_t rhs = (*(struct event **)(b))->timestamp;
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+uint64_t event_key(const void *arg) {
+    return (*(struct event **)(arg))->timestamp;
+}
+
+void fill(vector_t *v, struct event *events, enum pattern pattern) {
+    unsigned long state = 12345;
+
+    vector_clear(v);
+
+    for (long i = 0; i < LENGTH; i++) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+
+        switch (pattern) {
+        case RANDOM:
+            events[i].timestamp = state ^ (state >> 29);
+            break;
+        case SORTED:
+            events[i].timestamp = 1700000000000000000UL + i * 1000;
+            break;
+        case NARROW:
+        default:
+            // Nanosecond timestamps within one second: the high bytes are
+            // equal in every key, and their passes are skipped.
+            events[i].timestamp = 1700000000000000000UL + (state >> 34);
+            break;
+        }
+
+        struct event *ptr = &events[i];
+        vector_push_back(v, &ptr);
+    }
+}
+
+double bench_sort(vector_t *v, void (*sort)(vector_t *, int (*)(const void *, const void *))) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    sort(v, event_compare);
+    return elapsed_ms(&start);
+}
+
+double bench_radix_sort(vector_t *v) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    vector_radix_sort_by_key(v, event_key);
+    return elapsed_ms(&start);
+}
+
+double bench_parallel_radix_sort(vector_t *v) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    vector_parallel_radix_sort_by_key(v, event_key, 0);
+    return elapsed_ms(&start);
+}
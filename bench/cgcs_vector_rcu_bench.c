@@ -0,0 +1,119 @@
+/*!
+    \file       cgcs_vector_rcu_bench.c
+    \brief      Benchmark: lookups under a pthread_rwlock_t
+                vs. vector_rcu_read_lock
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_rcu.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define TABLE_SIZE 1024
+#define LOOKUPS 1000000
+#define MAX_THREADS 8
+
+vector_t locked;
+pthread_rwlock_t locked_rwlock = PTHREAD_RWLOCK_INITIALIZER;
+vector_rcu_t rcu;
+
+int size_t_compare(const void *a, const void *b);
+void fill(vector_t *v);
+
+void *lookup_locked(void *arg);
+void *lookup_rcu(void *arg);
+
+double bench(void *(*lookup)(void *), size_t nthreads);
+
+int main(int argc, const char *argv[]) {
+    vector_t *draft = NULL;
+
+    vector_init_elem(&locked, TABLE_SIZE, sizeof(size_t));
+    fill(&locked);
+
+    vector_rcu_init_elem(&rcu, TABLE_SIZE, sizeof(size_t));
+    draft = vector_rcu_write_begin(&rcu);
+    fill(draft);
+    vector_rcu_write_commit(&rcu);
+
+    printf("%d vector_bsearch lookups per thread in a %d-entry table (ms)\n\n",
+           LOOKUPS, TABLE_SIZE);
+    printf("%-8s %12s %12s\n", "threads", "rwlock", "rcu");
+
+    for (size_t nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2) {
+        printf("%-8zu %12.2f %12.2f\n", nthreads,
+               bench(lookup_locked, nthreads), bench(lookup_rcu, nthreads));
+    }
+
+    vector_rcu_deinit(&rcu);
+    vector_deinit(&locked);
+
+    return EXIT_SUCCESS;
+}
+
+int size_t_compare(const void *a, const void *b) {
+    const size_t x = *(const size_t *)(a);
+    const size_t y = *(const size_t *)(b);
+
+    return (x > y) - (x < y);
+}
+
+void fill(vector_t *v) {
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        const size_t key = i * 2;
+        vector_push_back(v, &key);
+    }
+}
+
+void *lookup_locked(void *arg) {
+    size_t found = 0;
+
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        const size_t key = i % (TABLE_SIZE * 2);
+
+        pthread_rwlock_rdlock(&locked_rwlock);
+        found += vector_bsearch(&locked, size_t_compare, &key) != NULL;
+        pthread_rwlock_unlock(&locked_rwlock);
+    }
+
+    return (void *)found;
+}
+
+void *lookup_rcu(void *arg) {
+    vector_rcu_reader_t reader;
+    size_t found = 0;
+
+    vector_rcu_reader_register(&rcu, &reader);
+
+    for (size_t i = 0; i < LOOKUPS; i++) {
+        const size_t key = i % (TABLE_SIZE * 2);
+        vector_t *snapshot = vector_rcu_read_lock(&rcu, &reader);
+
+        found += vector_bsearch(snapshot, size_t_compare, &key) != NULL;
+        vector_rcu_read_unlock(&rcu, &reader);
+    }
+
+    vector_rcu_reader_unregister(&rcu, &reader);
+    return (void *)found;
+}
+
+double bench(void *(*lookup)(void *), size_t nthreads) {
+    pthread_t threads[MAX_THREADS];
+    struct timespec start;
+
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t t = 0; t < nthreads; t++) {
+        pthread_create(&threads[t], NULL, lookup, NULL);
+    }
+
+    for (size_t t = 0; t < nthreads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    return elapsed_ms(&start);
+}
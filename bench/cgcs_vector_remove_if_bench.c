@@ -0,0 +1,89 @@
+/*!
+    \file       cgcs_vector_remove_if_bench.c
+    \brief      Benchmark: filtering a vector_t with vector_erase in a loop
+                vs. vector_remove_if and vector_erase_positions
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector.h"
+#include "cgcs_vector_bench.h"
+
+#include <stdio.h>
+#include <time.h>
+
+bool is_odd(const void *block);
+
+void fill(vector_t *v, size_t length);
+
+int main(int argc, const char *argv[]) {
+    const size_t lengths[] = { 1 << 12, 1 << 14, 1 << 16, 1 << 18 };
+
+    printf("Erasing every odd pointer (ms)\n\n");
+    printf("%10s %18s %18s %24s %24s %34s\n", "length", "vector_erase loop", "vector_remove_if",
+           "vector_stable_partition", "vector_erase_positions",
+           "vector_erase_positions_unordered");
+
+    for (size_t k = 0; k < sizeof lengths / sizeof *lengths; k++) {
+        struct timespec start;
+        double erase_ms, remove_ms, partition_ms, positions_ms, unordered_ms;
+        size_t *odd = malloc(sizeof *odd * (lengths[k] / 2));
+        vector_t v;
+
+        vector_init(&v, lengths[k]);
+
+        for (size_t i = 0; i < lengths[k] / 2; i++) {
+            odd[i] = 2 * i + 1;
+        }
+
+        fill(&v, lengths[k]);
+        timespec_get(&start, TIME_UTC);
+
+        for (vector_iterator_t it = vector_begin(&v); it < vector_end(&v);) {
+            it = is_odd(it) ? vector_erase(&v, it) : vector_advance(&v, it, 1);
+        }
+
+        erase_ms = elapsed_ms(&start);
+
+        fill(&v, lengths[k]);
+        timespec_get(&start, TIME_UTC);
+        vector_remove_if(&v, is_odd);
+        remove_ms = elapsed_ms(&start);
+
+        fill(&v, lengths[k]);
+        timespec_get(&start, TIME_UTC);
+        vector_stable_partition(&v, is_odd);
+        partition_ms = elapsed_ms(&start);
+
+        fill(&v, lengths[k]);
+        timespec_get(&start, TIME_UTC);
+        vector_erase_positions(&v, odd, lengths[k] / 2);
+        positions_ms = elapsed_ms(&start);
+
+        fill(&v, lengths[k]);
+        timespec_get(&start, TIME_UTC);
+        vector_erase_positions_unordered(&v, odd, lengths[k] / 2);
+        unordered_ms = elapsed_ms(&start);
+
+        printf("%10zu %18.2f %18.2f %24.2f %24.2f %34.2f\n", lengths[k], erase_ms, remove_ms,
+               partition_ms, positions_ms, unordered_ms);
+        vector_deinit(&v);
+        free(odd);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+bool is_odd(const void *block) {
+    return (uintptr_t)*(void *const *)block & 1;
+}
+
+void fill(vector_t *v, size_t length) {
+    vector_clear(v);
+
+    for (uintptr_t i = 0; i < length; i++) {
+        void *value = (void *)i;
+        vector_push_back(v, &value);
+    }
+}
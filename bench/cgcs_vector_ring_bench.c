@@ -0,0 +1,110 @@
+/*!
+    \file       cgcs_vector_ring_bench.c
+    \brief      Benchmark: vector_t used as a queue vs. vector_ring_t
+                and vector_spsc_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_ring.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define OPERATIONS 200000
+
+double bench_vector(size_t depth);
+double bench_ring(size_t depth);
+double bench_spsc(size_t depth);
+
+int main(int argc, const char *argv[]) {
+    printf("%d enqueue/dequeue pairs on a queue holding depth pointers (ms)\n\n", OPERATIONS);
+    printf("%-8s %14s %14s %14s\n", "depth", "vector_t", "vector_ring_t", "vector_spsc_t");
+
+    for (size_t depth = 16; depth <= 16384; depth *= 8) {
+        printf("%-8zu %14.2f %14.2f %14.2f\n", depth,
+               bench_vector(depth), bench_ring(depth), bench_spsc(depth));
+    }
+
+    return EXIT_SUCCESS;
+}
+
+double bench_vector(size_t depth) {
+    struct timespec start;
+    vector_t v;
+
+    vector_init(&v, depth + 1);
+
+    for (size_t i = 0; i < depth; i++) {
+        void *value = (void *)i;
+        vector_push_back(&v, &value);
+    }
+
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < OPERATIONS; i++) {
+        void *value = (void *)i;
+
+        vector_push_back(&v, &value);
+        vector_erase(&v, vector_begin(&v));
+    }
+
+    double ms = elapsed_ms(&start);
+    vector_deinit(&v);
+
+    return ms;
+}
+
+double bench_ring(size_t depth) {
+    struct timespec start;
+    vector_ring_t r;
+
+    vector_ring_init(&r, depth + 1);
+
+    for (size_t i = 0; i < depth; i++) {
+        void *value = (void *)i;
+        vector_ring_push_back(&r, &value);
+    }
+
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < OPERATIONS; i++) {
+        void *value = (void *)i;
+
+        vector_ring_push_back(&r, &value);
+        vector_ring_pop_front(&r);
+    }
+
+    double ms = elapsed_ms(&start);
+    vector_ring_deinit(&r);
+
+    return ms;
+}
+
+double bench_spsc(size_t depth) {
+    struct timespec start;
+    vector_spsc_t q;
+
+    vector_spsc_init(&q, depth + 1);
+
+    for (size_t i = 0; i < depth; i++) {
+        void *value = (void *)i;
+        vector_spsc_push(&q, &value);
+    }
+
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < OPERATIONS; i++) {
+        void *value = (void *)i;
+
+        vector_spsc_push(&q, &value);
+        vector_spsc_pop(&q, &value);
+    }
+
+    double ms = elapsed_ms(&start);
+    vector_spsc_deinit(&q);
+
+    return ms;
+}
@@ -0,0 +1,100 @@
+/*!
+    \file       cgcs_vector_segmented_bench.c
+    \brief      Benchmark: growing and indexing vector_t vs. vector_segmented_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_segmented.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define LENGTH (1 << 24)
+
+int main(int argc, const char *argv[]) {
+    struct timespec start;
+    double vector_push_ms, vector_worst_ms = 0, vector_index_ms;
+    double segmented_push_ms, segmented_worst_ms = 0, segmented_index_ms;
+    size_t vector_sum = 0, segmented_sum = 0;
+    vector_t v;
+    vector_segmented_t s;
+
+    vector_init(&v, 16);
+    vector_segmented_init(&s, 16);
+
+    // Pushes that cross a capacity boundary are timed on their own,
+    // to show the stall of moving the whole buffer.
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < LENGTH; i++) {
+        void *value = (void *)i;
+
+        if (vector_size(&v) == vector_capacity(&v)) {
+            struct timespec grow;
+            double ms;
+
+            timespec_get(&grow, TIME_UTC);
+            vector_push_back(&v, &value);
+            ms = elapsed_ms(&grow);
+            vector_worst_ms = ms > vector_worst_ms ? ms : vector_worst_ms;
+        } else {
+            vector_push_back(&v, &value);
+        }
+    }
+
+    vector_push_ms = elapsed_ms(&start);
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < LENGTH; i++) {
+        void *value = (void *)i;
+
+        if (vector_segmented_size(&s) == vector_segmented_capacity(&s)) {
+            struct timespec grow;
+            double ms;
+
+            timespec_get(&grow, TIME_UTC);
+            vector_segmented_push_back(&s, &value);
+            ms = elapsed_ms(&grow);
+            segmented_worst_ms = ms > segmented_worst_ms ? ms : segmented_worst_ms;
+        } else {
+            vector_segmented_push_back(&s, &value);
+        }
+    }
+
+    segmented_push_ms = elapsed_ms(&start);
+
+    // Strided, so neither is a plain sequential scan.
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < LENGTH; i++) {
+        vector_sum += (size_t)*(void **)vector_i(&v, (i * 7919) & (LENGTH - 1));
+    }
+
+    vector_index_ms = elapsed_ms(&start);
+    timespec_get(&start, TIME_UTC);
+
+    for (size_t i = 0; i < LENGTH; i++) {
+        segmented_sum += (size_t)*(void **)vector_segmented_at(&s, (i * 7919) & (LENGTH - 1));
+    }
+
+    segmented_index_ms = elapsed_ms(&start);
+
+    printf("%d pointers, grown from 16 (ms)\n\n", LENGTH);
+    printf("%-20s %12s %16s %16s\n", "", "push_back", "worst growth", "indexed reads");
+    printf("%-20s %12.2f %16.2f %16.2f\n", "vector_t",
+           vector_push_ms, vector_worst_ms, vector_index_ms);
+    printf("%-20s %12.2f %16.2f %16.2f\n", "vector_segmented_t",
+           segmented_push_ms, segmented_worst_ms, segmented_index_ms);
+
+    if (vector_sum != segmented_sum) {
+        return EXIT_FAILURE;
+    }
+
+    vector_segmented_deinit(&s);
+    vector_deinit(&v);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/*!
+    \file       cgcs_vector_sort_bench.c
+    \brief      Benchmark: libc qsort vs. the vector_*sort* family
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector.h"
+#include "cgcs_vector_bench.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LENGTH 1000000
+
+enum pattern { RANDOM, SORTED, REVERSED, FEW_UNIQUE, PATTERN_COUNT };
+
+const char *pattern_names[] = { "random", "sorted", "reversed", "few unique" };
+
+int long_compare(const void *a, const void *b);
+void fill(vector_t *v, long *values, enum pattern pattern);
+
+double bench_libc_qsort(vector_t *v);
+double bench_sort(vector_t *v, void (*sort)(vector_t *, int (*)(const void *, const void *)));
+
+int main(int argc, const char *argv[]) {
+    long *values = malloc(sizeof *values * LENGTH);
+    vector_t v;
+
+    vector_init(&v, LENGTH);
+
+    printf("%d pointers to long\n\n", LENGTH);
+    printf("%-12s %12s %14s %18s %17s\n",
+           "", "libc qsort", "vector_qsort", "vector_mergesort", "vector_heapsort");
+
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+        double libc_ms, qsort_ms, mergesort_ms, heapsort_ms;
+
+        fill(&v, values, p);
+        libc_ms = bench_libc_qsort(&v);
+
+        fill(&v, values, p);
+        qsort_ms = bench_sort(&v, vector_qsort);
+
+        fill(&v, values, p);
+        mergesort_ms = bench_sort(&v, vector_mergesort);
+
+        fill(&v, values, p);
+        heapsort_ms = bench_sort(&v, vector_heapsort);
+
+        printf("%-12s %9.2f ms %11.2f ms %15.2f ms %14.2f ms\n",
+               pattern_names[p], libc_ms, qsort_ms, mergesort_ms, heapsort_ms);
+    }
+
+    vector_deinit(&v);
+    free(values);
+
+    return EXIT_SUCCESS;
+}
+
+int long_compare(const void *a, const void *b) {
+    const long lhs = **(long **)(a);
+    const long rhs = **(long **)(b);
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+void fill(vector_t *v, long *values, enum pattern pattern) {
+    unsigned long state = 12345;
+
+    vector_clear(v);
+
+    for (long i = 0; i < LENGTH; i++) {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+
+        switch (pattern) {
+        case RANDOM:
+            values[i] = (long)(state >> 33);
+            break;
+        case SORTED:
+            values[i] = i;
+            break;
+        case REVERSED:
+            values[i] = LENGTH - i;
+            break;
+        case FEW_UNIQUE:
+        default:
+            values[i] = (long)(state >> 33) % 16;
+            break;
+        }
+
+        long *ptr = &values[i];
+        vector_push_back(v, &ptr);
+    }
+}
+
+double bench_libc_qsort(vector_t *v) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    qsort(vector_begin(v), vector_size(v), sizeof(voidptr), long_compare);
+    return elapsed_ms(&start);
+}
+
+double bench_sort(vector_t *v, void (*sort)(vector_t *, int (*)(const void *, const void *))) {
+    struct timespec start;
+    timespec_get(&start, TIME_UTC);
+
+    sort(v, long_compare);
+    return elapsed_ms(&start);
+}
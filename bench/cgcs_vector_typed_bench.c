@@ -0,0 +1,115 @@
+/*!
+    \file       cgcs_vector_typed_bench.c
+    \brief      Benchmark: vector_t with a comparator pointer vs. CGCS_VECTOR_DEFINE
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector.h"
+#include "cgcs_vector_bench.h"
+#include "cgcs_vector_typed.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#define LENGTH 1000000
+#define FIND_LENGTH 4096
+#define FINDS 20000
+
+static inline int long_cmp(const long *a, const long *b) {
+    return (*a > *b) - (*a < *b);
+}
+
+CGCS_VECTOR_DEFINE(vec_long, long, long_cmp)
+
+int long_compare(const void *a, const void *b);
+long next_value(unsigned long *state);
+
+int main(int argc, const char *argv[]) {
+    double vector_sort_ms, typed_sort_ms, vector_find_ms, typed_find_ms;
+    unsigned long state = 12345;
+    long vector_hits = 0, typed_hits = 0;
+    struct timespec start;
+    vector_t v;
+    vec_long_t t;
+
+    vector_init_elem(&v, LENGTH, sizeof(long));
+    vec_long_init(&t, LENGTH);
+
+    for (long i = 0; i < LENGTH; i++) {
+        const long value = next_value(&state);
+
+        vector_push_back(&v, &value);
+        vec_long_push_back(&t, value);
+    }
+
+    // Sorting: every comparison through a pointer vs. inlined.
+    timespec_get(&start, TIME_UTC);
+    vector_qsort(&v, long_compare);
+    vector_sort_ms = elapsed_ms(&start);
+
+    timespec_get(&start, TIME_UTC);
+    vec_long_qsort(&t);
+    typed_sort_ms = elapsed_ms(&start);
+
+    for (long i = 0; i < LENGTH; i++) {
+        if (*(long *)vector_i(&v, i) != *vec_long_i(&t, i)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Linear search over a short, unsorted prefix; about half the keys miss.
+    vector_clear(&v);
+    vec_long_clear(&t);
+
+    for (long i = 0; i < FIND_LENGTH; i++) {
+        const long value = next_value(&state);
+
+        vector_push_back(&v, &value);
+        vec_long_push_back(&t, value);
+    }
+
+    unsigned long key_state = state;
+
+    timespec_get(&start, TIME_UTC);
+
+    for (int i = 0; i < FINDS; i++) {
+        const long key = i % 2 ? *(long *)vector_i(&v, i % FIND_LENGTH) : next_value(&key_state);
+        vector_hits += vector_find(&v, long_compare, &key) != NULL;
+    }
+
+    vector_find_ms = elapsed_ms(&start);
+
+    key_state = state;
+    timespec_get(&start, TIME_UTC);
+
+    for (int i = 0; i < FINDS; i++) {
+        const long key = i % 2 ? *vec_long_i(&t, i % FIND_LENGTH) : next_value(&key_state);
+        typed_hits += vec_long_find(&t, &key) != NULL;
+    }
+
+    typed_find_ms = elapsed_ms(&start);
+
+    printf("%d longs sorted, %d finds in %d longs (ms)\n\n", LENGTH, FINDS, FIND_LENGTH);
+    printf("%-20s %12s %12s\n", "", "qsort", "find");
+    printf("%-20s %12.2f %12.2f\n", "vector_t", vector_sort_ms, vector_find_ms);
+    printf("%-20s %12.2f %12.2f\n", "CGCS_VECTOR_DEFINE", typed_sort_ms, typed_find_ms);
+
+    vec_long_deinit(&t);
+    vector_deinit(&v);
+
+    return vector_hits == typed_hits ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int long_compare(const void *a, const void *b) {
+    const long lhs = *(const long *)(a);
+    const long rhs = *(const long *)(b);
+
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+long next_value(unsigned long *state) {
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return (long)(*state >> 33);
+}
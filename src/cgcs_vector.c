@@ -9,11 +9,61 @@
 // TODO: Fill in all documentation stubs
 
 #include "cgcs_vector.h"
+#include "cgcs_vector_index_impl.h"
+#include "cgcs_vector_sort.h"
 
 #include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#define cgcs_malloc_usable_size(ptr) malloc_size(ptr)
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#define cgcs_malloc_usable_size(ptr) malloc_usable_size(ptr)
+#else
+#define cgcs_malloc_usable_size(ptr) ((size_t)(0))
+#endif
+
+typedef int (*cgcs_vector_cmpfn)(const void *, const void *);
+typedef int (^cgcs_vector_cmp_b)(const void *, const void *);
+
+// cmp is given the addresses of two blocks (as with qsort).
+#define cgcs_vector_less(cmp, a, b) ((cmp)((a), (b)) < 0)
+
+// a and b address slots that hold the addresses of two blocks;
+// used to sort vectors made with vector_init_elem by address.
+#define cgcs_vector_less_indirect(cmp, a, b) ((cmp)(*(a), *(b)) < 0)
+
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_sort_fn, voidptr, cgcs_vector_cmpfn, cgcs_vector_less)
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_sort_b, voidptr, cgcs_vector_cmp_b, cgcs_vector_less)
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_sort_indirect_fn, voidptr, cgcs_vector_cmpfn, cgcs_vector_less_indirect)
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_sort_indirect_b, voidptr, cgcs_vector_cmp_b, cgcs_vector_less_indirect)
+
+static void *cgcs_vector_malloc_allocfn(void *ctx, size_t size);
+static void *cgcs_vector_malloc_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void cgcs_vector_malloc_freefn(void *ctx, void *ptr, size_t size);
+
+const vector_allocator_t cgcs_vector_malloc_allocator = {
+    cgcs_vector_malloc_allocfn,
+    cgcs_vector_malloc_reallocfn,
+    cgcs_vector_malloc_freefn,
+    NULL
+};
+
+static void *cgcs_vector_malloc_allocfn(void *ctx, size_t size) {
+    return malloc(size);
+}
+
+static void *cgcs_vector_malloc_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    return realloc(ptr, new_size);
+}
+
+static void cgcs_vector_malloc_freefn(void *ctx, void *ptr, size_t size) {
+    free(ptr);
+}
+
 /*!
     \brief
 
@@ -24,6 +74,49 @@ cgcs_vector_base_initialize(struct cgcs_vector_base *base) {
     base->m_start = NULL;
     base->m_finish = NULL;
     base->m_end_of_storage = NULL;
+    base->m_inline = NULL;
+}
+
+/*!
+    \brief      Determines if base is still using its caller-owned inline buffer
+
+    \param[in]  base
+
+    \return
+*/
+static inline bool
+cgcs_vector_base_using_inline(struct cgcs_vector_base *base) {
+    return base->m_inline && base->m_start == base->m_inline;
+}
+
+/*!
+    \brief      Returns the address n blocks away from pos
+
+    \param[in]  base
+    \param[in]  pos
+    \param[in]  n
+
+    \return
+*/
+static inline voidptr *
+cgcs_vector_base_offset(struct cgcs_vector_base *base, voidptr *pos, ptrdiff_t n) {
+    return (voidptr *)((char *)pos + n * (ptrdiff_t)base->m_elem_size);
+}
+
+/*!
+    \brief      Copies one block from valaddr into dst
+
+    \param[in]  base
+    \param[in]  dst
+    \param[in]  valaddr
+*/
+static inline void
+cgcs_vector_base_assign(struct cgcs_vector_base *base, voidptr *dst, const void *valaddr) {
+    if (base->m_elem_size == sizeof *dst) {
+        *(dst) = *(void **)(valaddr);
+    } else {
+        memcpy(dst, valaddr, base->m_elem_size);
+    }
 }
 
 /*!
@@ -31,16 +124,22 @@ cgcs_vector_base_initialize(struct cgcs_vector_base *base) {
 
     \param[in]  base
     \param[in]  capacity
+    \param[in]  zero
 */
 static inline void
 cgcs_vector_base_new_block(struct cgcs_vector_base *base,
-                               size_t capacity) {
-    voidptr *start = calloc(capacity, sizeof *start);
+                               size_t capacity, bool zero) {
+    const size_t size = base->m_elem_size * capacity;
+    voidptr *start = base->m_alloc->m_allocfn(base->m_alloc->m_ctx, size);
     assert(start);
 
+    if (zero) {
+        memset(start, 0, size);
+    }
+
     base->m_start = start;
     base->m_finish = base->m_start;
-    base->m_end_of_storage = base->m_start + capacity;
+    base->m_end_of_storage = cgcs_vector_base_offset(base, base->m_start, capacity);
 }
 
 /*!
@@ -49,17 +148,21 @@ cgcs_vector_base_new_block(struct cgcs_vector_base *base,
     \param[in]  base
     \param[in]  capacity
     \param[in]  allocfn
+    \param[in]  zero
  */
 static inline void
 cgcs_vector_base_new_block_allocfn(struct cgcs_vector_base *base,
                                     size_t capacity,
-                                    void *(*allocfn)(size_t)) {
-    base->m_start = allocfn(sizeof base->m_start * capacity);
+                                    void *(*allocfn)(size_t), bool zero) {
+    base->m_start = allocfn(base->m_elem_size * capacity);
     assert(base->m_start);
-    memset(base->m_start, 0, sizeof *base->m_start * capacity);
+
+    if (zero) {
+        memset(base->m_start, 0, base->m_elem_size * capacity);
+    }
 
     base->m_finish = base->m_start;
-    base->m_end_of_storage = base->m_start + capacity;
+    base->m_end_of_storage = cgcs_vector_base_offset(base, base->m_start, capacity);
 }
 
 /*!
@@ -72,12 +175,33 @@ cgcs_vector_base_new_block_allocfn(struct cgcs_vector_base *base,
 static inline void
 cgcs_vector_base_resize_block(struct cgcs_vector_base *base,
                                   size_t size, size_t capacity) {
-    voidptr *start = realloc(base->m_start, sizeof *start * capacity);
-    assert(start);
+    const vector_allocator_t *alloc = base->m_alloc;
+    const size_t old_size = (char *)base->m_end_of_storage - (char *)base->m_start;
+    const size_t new_size = base->m_elem_size * capacity;
+    voidptr *start = NULL;
+
+    if (cgcs_vector_base_using_inline(base)) {
+        // The inline buffer is not ours to realloc,
+        // so we spill its contents over to a new block.
+        start = alloc->m_allocfn(alloc->m_ctx, new_size);
+        assert(start);
+        memcpy(start, base->m_start, base->m_elem_size * size);
+    } else if (alloc->m_reallocfn) {
+        // The allocator may be able to resize the block in place.
+        start = alloc->m_reallocfn(alloc->m_ctx, base->m_start, old_size, new_size);
+        assert(start);
+    } else {
+        start = alloc->m_allocfn(alloc->m_ctx, new_size);
+        assert(start);
+
+        // Only [m_start, m_finish) is worth copying.
+        memcpy(start, base->m_start, base->m_elem_size * size);
+        alloc->m_freefn(alloc->m_ctx, base->m_start, old_size);
+    }
 
     base->m_start = start;
-    base->m_finish = base->m_start + size;
-    base->m_end_of_storage = base->m_start + capacity;
+    base->m_finish = cgcs_vector_base_offset(base, base->m_start, size);
+    base->m_end_of_storage = cgcs_vector_base_offset(base, base->m_start, capacity);
 }
 
 /*!
@@ -95,14 +219,31 @@ cgcs_vector_base_resize_block_allocfreefn(struct cgcs_vector_base *base,
                                   void *(*allocfn)(size_t), void (*freefn)(void *)) {
     voidptr *old_start = base->m_start;
 
-    base->m_start = allocfn(sizeof *base->m_start * capacity);
+    base->m_start = allocfn(base->m_elem_size * capacity);
     assert(base->m_start);
-    memcpy(base->m_start, old_start, sizeof *old_start * size);
+    memcpy(base->m_start, old_start, base->m_elem_size * size);
+
+    if (old_start != base->m_inline) {
+        freefn(old_start);
+    }
+
+    base->m_finish = cgcs_vector_base_offset(base, base->m_start, size);
+    base->m_end_of_storage = cgcs_vector_base_offset(base, base->m_start, capacity);
+}
+
+/*!
+    \brief      Returns base's buffer to its allocator
 
-    freefn(old_start);
+    \param[in]  base
+*/
+static inline void
+cgcs_vector_base_delete_block(struct cgcs_vector_base *base) {
+    const vector_allocator_t *alloc = base->m_alloc;
 
-    base->m_finish = base->m_start + size;
-    base->m_end_of_storage = base->m_start + capacity;
+    if (base->m_start && cgcs_vector_base_using_inline(base) == false) {
+        alloc->m_freefn(alloc->m_ctx, base->m_start,
+                        (char *)base->m_end_of_storage - (char *)base->m_start);
+    }
 }
 
 /*!
@@ -124,8 +265,7 @@ cgcs_vector_base_full_capacity(struct cgcs_vector_base *base) {
     \param[in]     capacity
 */
 void vector_init(vector_t *self, size_t capacity) {
-    cgcs_vector_base_initialize(&(self->m_impl));
-    cgcs_vector_base_new_block(&(self->m_impl), capacity);
+    vector_init_elem(self, capacity, sizeof(voidptr));
 }
 
 /*!
@@ -135,8 +275,188 @@ void vector_init(vector_t *self, size_t capacity) {
     \param[in]     capacity
 */
 void vector_init_alloc_fn(vector_t *self, size_t capacity, void *(*allocfn)(size_t)) {
+    vector_init_elem_alloc_fn(self, capacity, sizeof(voidptr), allocfn);
+}
+
+/*!
+    \brief      Initializes a vector whose blocks are elem_size bytes wide
+
+    Rather than storing pointers, the vector stores copies of
+    elem_size-byte values contiguously in its buffer.
+    valaddr arguments (i.e. vector_push_back) address the value to copy,
+    and iterators address the stored values directly.
+    Use vector_advance/vector_distance to move between blocks.
+
+    \param[in]     self
+    \param[in]     capacity
+    \param[in]     elem_size
+*/
+void vector_init_elem(vector_t *self, size_t capacity, size_t elem_size) {
+    vector_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]     self
+    \param[in]     capacity
+    \param[in]     elem_size
+    \param[in]     allocfn
+*/
+void vector_init_elem_alloc_fn(vector_t *self, size_t capacity, size_t elem_size,
+                             void *(*allocfn)(size_t)) {
+    vector_init_elem_alloc_fn_fill(self, capacity, elem_size, allocfn, CGCS_VECTOR_FILL_ZERO);
+}
+
+/*!
+    \brief      Initializes a vector whose buffer comes from allocfn,
+                choosing whether storage it is not using is zeroed
+
+    See vector_init_elem_allocator_fill.
+
+    \param[in]     self
+    \param[in]     capacity
+    \param[in]     elem_size
+    \param[in]     allocfn
+    \param[in]     fill
+*/
+void vector_init_elem_alloc_fn_fill(vector_t *self, size_t capacity, size_t elem_size,
+                                   void *(*allocfn)(size_t), enum cgcs_vector_fill fill) {
+    assert(elem_size > 0);
+
+    cgcs_vector_base_initialize(&(self->m_impl));
+    self->m_impl.m_elem_size = elem_size;
+
+    // The buffer comes from allocfn, but vector_deinit (and vector_resize)
+    // have always assumed free (and realloc) are compatible with it.
+    self->m_impl.m_alloc = &cgcs_vector_malloc_allocator;
+    cgcs_vector_base_new_block_allocfn(&(self->m_impl), capacity, allocfn,
+                                       fill == CGCS_VECTOR_FILL_ZERO);
+
+    vector_set_growth(self, CGCS_VECTOR_GROWTH_FACTOR_2, 0);
+    vector_set_fill(self, fill);
+    self->m_index = NULL;
+}
+
+/*!
+    \brief      Initializes a vector whose buffer is managed by alloc
+
+    alloc is not copied; it must outlive the vector.
+
+    \param[in]     self
+    \param[in]     capacity
+    \param[in]     alloc
+*/
+void vector_init_allocator(vector_t *self, size_t capacity,
+                           const vector_allocator_t *alloc) {
+    vector_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief
+
+    \param[in]     self
+    \param[in]     capacity
+    \param[in]     elem_size
+    \param[in]     alloc
+*/
+void vector_init_elem_allocator(vector_t *self, size_t capacity, size_t elem_size,
+                                const vector_allocator_t *alloc) {
+    vector_init_elem_allocator_fill(self, capacity, elem_size, alloc, CGCS_VECTOR_FILL_ZERO);
+}
+
+/*!
+    \brief      Initializes a vector whose buffer is managed by alloc,
+                choosing whether storage it is not using is zeroed
+
+    With CGCS_VECTOR_FILL_NONE, neither this call nor vector_clear
+    touch the buffer, so initializing a vector costs only an allocation
+    (see cgcs_vector_cache.h for one that is usually free).
+
+    \param[in]     self
+    \param[in]     capacity
+    \param[in]     elem_size
+    \param[in]     alloc
+    \param[in]     fill
+*/
+void vector_init_elem_allocator_fill(vector_t *self, size_t capacity, size_t elem_size,
+                                     const vector_allocator_t *alloc, enum cgcs_vector_fill fill) {
+    assert(elem_size > 0);
+    assert(alloc);
+
+    cgcs_vector_base_initialize(&(self->m_impl));
+    self->m_impl.m_elem_size = elem_size;
+    self->m_impl.m_alloc = alloc;
+    cgcs_vector_base_new_block(&(self->m_impl), capacity, fill == CGCS_VECTOR_FILL_ZERO);
+
+    vector_set_growth(self, CGCS_VECTOR_GROWTH_FACTOR_2, 0);
+    vector_set_fill(self, fill);
+    self->m_index = NULL;
+}
+
+/*!
+    \brief      Initializes a vector that uses buf as its storage
+                until it needs more than capacity blocks
+
+    buf is owned by the caller and must outlive the vector
+    (see CGCS_VECTOR_SMALL). No allocation takes place until
+    the vector outgrows buf; vector_deinit will not free buf.
+
+    \param[in]     self
+    \param[in]     buf
+    \param[in]     capacity
+*/
+void vector_init_small(vector_t *self, voidptr *buf, size_t capacity) {
+    vector_init_small_elem(self, buf, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]     self
+    \param[in]     buf
+    \param[in]     capacity
+    \param[in]     elem_size
+*/
+void vector_init_small_elem(vector_t *self, void *buf, size_t capacity, size_t elem_size) {
+    assert(buf);
+    assert(elem_size > 0);
+
     cgcs_vector_base_initialize(&(self->m_impl));
-    cgcs_vector_base_new_block_allocfn(&(self->m_impl), capacity, allocfn);
+    self->m_impl.m_elem_size = elem_size;
+    self->m_impl.m_alloc = &cgcs_vector_malloc_allocator;
+    self->m_impl.m_inline = buf;
+
+    self->m_impl.m_start = buf;
+    self->m_impl.m_finish = self->m_impl.m_start;
+    self->m_impl.m_end_of_storage = cgcs_vector_base_offset(&(self->m_impl), buf, capacity);
+
+    vector_set_growth(self, CGCS_VECTOR_GROWTH_FACTOR_2, 0);
+    vector_set_fill(self, CGCS_VECTOR_FILL_ZERO);
+    self->m_index = NULL;
+}
+
+/*!
+    \brief      Chooses how self grows once it is full
+
+    \param[in]  self
+    \param[in]  growth
+    \param[in]  increment  blocks added per growth,
+                           if growth is CGCS_VECTOR_GROWTH_ADDITIVE
+*/
+void vector_set_growth(vector_t *self, enum cgcs_vector_growth growth, size_t increment) {
+    self->m_growth = growth;
+    self->m_growth_increment = increment;
+}
+
+/*!
+    \brief      Chooses whether vector_clear zeroes the blocks it drops
+
+    \param[in]  self
+    \param[in]  fill
+*/
+void vector_set_fill(vector_t *self, enum cgcs_vector_fill fill) {
+    self->m_fill = fill;
 }
 
 /*!
@@ -153,7 +473,8 @@ void vector_deinit(vector_t *self) {
     // in vptr's buffer, run a "destroy" function on each element
     // using vector_foreach -- or iterate over all elements manually
     // and free each pointer as needed.
-    free(self->m_impl.m_start);
+    vector_index_detach(self);
+    cgcs_vector_base_delete_block(&(self->m_impl));
     cgcs_vector_base_initialize(&(self->m_impl));
 }
 
@@ -166,7 +487,12 @@ void vector_deinit(vector_t *self) {
     \return
 */
 void vector_deinit_free_fn(vector_t *self, void (*freefn)(void *)) {
-    freefn(self->m_impl.m_start);
+    vector_index_detach(self);
+
+    if (cgcs_vector_base_using_inline(&(self->m_impl)) == false) {
+        freefn(self->m_impl.m_start);
+    }
+
     cgcs_vector_base_initialize(&(self->m_impl));
 }
 
@@ -219,7 +545,16 @@ bool vector_shrink_to_fit(vector_t *self) {
     const size_t capacity = vector_capacity(self);
     const size_t size = vector_size(self);
 
-    return (capacity > size) ? vector_resize(self, size) : false;
+    // An empty vector keeps one block,
+    // so that m_start always addresses a live block.
+    const size_t n = size > 0 ? size : 1;
+
+    if (capacity > n && cgcs_vector_base_using_inline(&(self->m_impl)) == false) {
+        cgcs_vector_base_resize_block(&(self->m_impl), size, n);
+        return true;
+    } else {
+        return false;
+    }
 }
 
 /*!
@@ -235,8 +570,91 @@ bool vector_shrink_to_fit_alloc_free_fn(vector_t *self,
                                      void *(*allocfn)(size_t), void (*freefn)(void *)) {
     const size_t capacity = vector_capacity(self);
     const size_t size = vector_size(self);
+    const size_t n = size > 0 ? size : 1;
+
+    if (capacity > n && cgcs_vector_base_using_inline(&(self->m_impl)) == false) {
+        cgcs_vector_base_resize_block_allocfreefn(&(self->m_impl), size, n, allocfn, freefn);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*!
+    \brief      Computes the capacity self should grow to,
+                so that it can hold at least required blocks
+
+    \param[in]  self
+    \param[in]  required
+
+    \return
+*/
+static inline size_t
+cgcs_vector_next_capacity(vector_t *self, size_t required) {
+    const size_t capacity = vector_capacity(self);
+    size_t next = 0;
+
+    switch (self->m_growth) {
+    case CGCS_VECTOR_GROWTH_FACTOR_1_5:
+        next = capacity + capacity / 2;
+        break;
+    case CGCS_VECTOR_GROWTH_ADDITIVE:
+        next = capacity + self->m_growth_increment;
+        break;
+    case CGCS_VECTOR_GROWTH_FACTOR_2:
+    case CGCS_VECTOR_GROWTH_USABLE_SIZE:
+    default:
+        next = capacity * 2;
+        break;
+    }
+
+    // A factor of 0 (or an increment of 0) would never grow,
+    // and a single doubling may not be enough for a range.
+    return next < required ? required : next;
+}
+
+/*!
+    \brief      Grows self so that it can hold at least required blocks,
+                honouring its growth policy
+
+    \param[in]  self
+    \param[in]  required
+*/
+static void
+cgcs_vector_grow(vector_t *self, size_t required) {
+    vector_resize(self, cgcs_vector_next_capacity(self, required));
+
+    if (self->m_growth == CGCS_VECTOR_GROWTH_USABLE_SIZE &&
+        self->m_impl.m_alloc == &cgcs_vector_malloc_allocator &&
+        cgcs_vector_base_using_inline(&(self->m_impl)) == false) {
+        // malloc rounds requests up to a size class;
+        // claim the slack as capacity rather than wasting it.
+        const size_t usable =
+            cgcs_malloc_usable_size(self->m_impl.m_start) / self->m_impl.m_elem_size;
+
+        if (usable > vector_capacity(self)) {
+            self->m_impl.m_end_of_storage =
+                cgcs_vector_base_offset(&(self->m_impl), self->m_impl.m_start, usable);
+        }
+    }
+}
+
+/*!
+    \brief      Like cgcs_vector_grow, for buffers managed by allocfn/freefn
 
-    return (capacity > size) ? vector_resize_alloc_free_fn(self, size, allocfn, freefn) : false;
+    Rounding up to malloc's usable size does not apply here,
+    since the buffer may not have come from malloc.
+
+    \param[in]  self
+    \param[in]  required
+    \param[in]  allocfn
+    \param[in]  freefn
+*/
+static void
+cgcs_vector_grow_allocfreefn(vector_t *self, size_t required,
+                             void *(*allocfn)(size_t), void (*freefn)(void *)) {
+    vector_resize_alloc_free_fn(self, cgcs_vector_next_capacity(self, required), 
+                                allocfn, freefn);
 }
 
 /*!
@@ -250,8 +668,8 @@ bool vector_shrink_to_fit_alloc_free_fn(vector_t *self,
 */
 vector_iterator_t vector_insert(vector_t *self, vector_iterator_t it, const void *valaddr) {
     if (cgcs_vector_base_full_capacity(&(self->m_impl))) {
-        size_t position = it - self->m_impl.m_start;
-        vector_resize(self, vector_capacity(self) * 2);
+        size_t position = vector_distance(self, self->m_impl.m_start, it);
+        cgcs_vector_grow(self, vector_size(self) + 1);
 
         // it must be updated if this vector is resized,
         // since we use it's address in memmove.
@@ -259,18 +677,22 @@ vector_iterator_t vector_insert(vector_t *self, vector_iterator_t it, const void
         // Without this reassignment, memmove will not work properly,
         // because it is assumed that it points to some address within
         // [ vector_begin(self), vector_end(self) )
-        it = self->m_impl.m_start + position;
+        it = vector_advance(self, self->m_impl.m_start, position);
     }
 
     // memmove(dst, src, block size)
     // We move everything from [it, m_finish) one block over right.
-    memmove(it + 1, it, sizeof *it * (self->m_impl.m_finish - it));
+    memmove(vector_advance(self, it, 1), it, (char *)self->m_impl.m_finish - (char *)it);
 
     // We've made room for the new element, so we make the assignment now.
-    *(it) = *(void **)(valaddr);
+    cgcs_vector_base_assign(&(self->m_impl), it, valaddr);
 
     // Finally, we advance the m_finish address one block.
-    ++self->m_impl.m_finish;
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, 1);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_distance(self, self->m_impl.m_start, it), 1);
+    }
 
     return it;
 }
@@ -290,8 +712,8 @@ vector_iterator_t vector_insert_alloc_free_fn(vector_t *self, vector_iterator_t
                                           const void *valaddr, 
                                           void *(*allocfn)(size_t), void (*freefn)(void *)) {    
     if (cgcs_vector_base_full_capacity(&(self->m_impl))) {
-        size_t position = it - self->m_impl.m_start;
-        vector_resize_alloc_free_fn(self, vector_capacity(self) * 2, allocfn, freefn);
+        size_t position = vector_distance(self, self->m_impl.m_start, it);
+        cgcs_vector_grow_allocfreefn(self, vector_size(self) + 1, allocfn, freefn);
 
         // it must be updated if this vector is resized,
         // since we use it's address in memmove.
@@ -299,18 +721,22 @@ vector_iterator_t vector_insert_alloc_free_fn(vector_t *self, vector_iterator_t
         // Without this reassignment, memmove will not work properly,
         // because it is assumed that it points to some address within
         // [ vector_begin(self), vector_end(self) )
-        it = self->m_impl.m_start + position;
+        it = vector_advance(self, self->m_impl.m_start, position);
     }
 
     // memmove(dst, src, block size)
     // We move everything from [it, m_finish) one block over right.
-    memmove(it + 1, it, sizeof *it * (self->m_impl.m_finish - it));
+    memmove(vector_advance(self, it, 1), it, (char *)self->m_impl.m_finish - (char *)it);
 
     // We've made room for the new element, so we make the assignment now.
-    *(it) = *(void **)(valaddr);
+    cgcs_vector_base_assign(&(self->m_impl), it, valaddr);
 
     // Finally, we advance the m_finish address one block.
-    ++self->m_impl.m_finish;
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, 1);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_distance(self, self->m_impl.m_start, it), 1);
+    }
 
     return it;
 }
@@ -327,27 +753,31 @@ vector_iterator_t vector_insert_alloc_free_fn(vector_t *self, vector_iterator_t
 */
 vector_iterator_t vector_insert_range(vector_t *self, vector_iterator_t it, vector_iterator_t beg,
                               vector_iterator_t end) {
-    const size_t count = end - beg;
-    size_t curr_capacity = vector_capacity(self);
+    const size_t count = vector_distance(self, beg, end);
+    const size_t required = vector_size(self) + count;
 
-    if (vector_size(self) + count > curr_capacity) {
-        size_t position = it - self->m_impl.m_start;
-        vector_resize(self, curr_capacity * 2);
+    if (required > vector_capacity(self)) {
+        size_t position = vector_distance(self, self->m_impl.m_start, it);
+        cgcs_vector_grow(self, required);
 
         // See vector_insert on why we update it
         // if we resize the buffer.
-        it = self->m_impl.m_start + position;
+        it = vector_advance(self, self->m_impl.m_start, position);
     }
 
     // memmove(dst, src, block size)
-    // We move everything from [it, m_finish) (m_finish - it) blocks over right.
-    memmove(it + count, it, sizeof *it * (self->m_impl.m_finish - it));
+    // We move everything from [it, m_finish) count blocks over right.
+    memmove(vector_advance(self, it, count), it, (char *)self->m_impl.m_finish - (char *)it);
 
     // Now we copy the contents in range [beg, end) at position it.
-    memcpy(it, beg, sizeof *it * count);
+    memcpy(it, beg, (char *)end - (char *)beg);
 
     // Finally, we advance the m_finish address count blocks.
-    self->m_impl.m_finish += count;
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, count);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_distance(self, self->m_impl.m_start, it), count);
+    }
 
     return it;
 }
@@ -370,27 +800,31 @@ vector_iterator_t vector_insert_range_alloc_free_fn(vector_t *self,
                                         vector_iterator_t end,
                                         void *(*allocfn)(size_t),
                                         void (*freefn)(void *)) {
-    const size_t count = end - beg;
-    size_t curr_capacity = vector_capacity(self);
+    const size_t count = vector_distance(self, beg, end);
+    const size_t required = vector_size(self) + count;
 
-    if (vector_size(self) + count > curr_capacity) {
-        size_t position = it - self->m_impl.m_start;
-        vector_resize_alloc_free_fn(self, curr_capacity * 2, allocfn, freefn);
+    if (required > vector_capacity(self)) {
+        size_t position = vector_distance(self, self->m_impl.m_start, it);
+        cgcs_vector_grow_allocfreefn(self, required, allocfn, freefn);
 
         // See vector_insert on why we update it
         // if we resize the buffer.
-        it = self->m_impl.m_start + position;
+        it = vector_advance(self, self->m_impl.m_start, position);
     }
 
     // memmove(dst, src, block size)
-    // We move everything from [it, m_finish) (m_finish - it) blocks over right.
-    memmove(it + count, it, sizeof *it * (self->m_impl.m_finish - it));
+    // We move everything from [it, m_finish) count blocks over right.
+    memmove(vector_advance(self, it, count), it, (char *)self->m_impl.m_finish - (char *)it);
 
     // Now we copy the contents in range [beg, end) at position it.
-    memcpy(it, beg, sizeof *it * count);
+    memcpy(it, beg, (char *)end - (char *)beg);
 
     // Finally, we advance the m_finish address count blocks.
-    self->m_impl.m_finish += count;
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, count);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_distance(self, self->m_impl.m_start, it), count);
+    }
 
     return it;
 }
@@ -405,13 +839,18 @@ vector_iterator_t vector_insert_range_alloc_free_fn(vector_t *self,
 */
 vector_iterator_t vector_erase(vector_t *self, vector_iterator_t it) {
     if (vector_empty(self) == false) {
-        const size_t move_element_count = self->m_impl.m_finish - it;
+        vector_iterator_t next = vector_advance(self, it, 1);
+
+        if (self->m_index) {
+            cgcs_vector_index_erase(self, vector_distance(self, self->m_impl.m_start, it), 1);
+        }
+
         // memmove(dst, src, block size)
         // We move everything from [it + 1, m_finish) one block over to the left.
-        memmove(it, it + 1, sizeof *it * move_element_count);
+        memmove(it, next, (char *)self->m_impl.m_finish - (char *)next);
 
         // Finally, we decrement the m_finish address one block.
-        --self->m_impl.m_finish;
+        self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, -1);
     }
 
     return it;
@@ -428,93 +867,498 @@ vector_iterator_t vector_erase(vector_t *self, vector_iterator_t it) {
 */
 vector_iterator_t vector_erase_range(vector_t *self, vector_iterator_t beg, vector_iterator_t end) {
     if (vector_empty(self) == false) {
-        const size_t move_element_count = self->m_impl.m_finish - beg;
-        const size_t count = end - beg;
+        const ptrdiff_t count = vector_distance(self, beg, end);
+
+        if (self->m_index) {
+            cgcs_vector_index_erase(self, vector_distance(self, self->m_impl.m_start, beg), count);
+        }
+
         // memmove(dst, src, block size)
-        // We move everything from [end, m_finish) one block over to the left.
-        memmove(beg, end, sizeof *beg * move_element_count);
+        // We move everything from [end, m_finish) count blocks over to the left.
+        memmove(beg, end, (char *)self->m_impl.m_finish - (char *)end);
 
         // Finally, we decrement the m_finish address count blocks.
-        self->m_impl.m_finish -= count;
+        self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, -count);
     }
 
     return beg;
 }
 
 /*!
-    \brief
+    \brief      Erases the block at it in O(1), by moving the last block
+                into its place
+
+    The order of the blocks is not kept.
 
     \param[in]  self
-    \param[in]  valaddr
+    \param[in]  it
+
+    \return     it, which now holds what was the last block
+                (or vector_end(self), if it was the last block)
 */
-void vector_push_back(vector_t *self, const void *valaddr) {
-    if (cgcs_vector_base_full_capacity(&(self->m_impl))) {
-        vector_resize(self, vector_capacity(self) * 2);
+vector_iterator_t vector_erase_unordered(vector_t *self, vector_iterator_t it) {
+    if (vector_empty(self) == false) {
+        vector_iterator_t last = vector_advance(self, self->m_impl.m_finish, -1);
+
+        if (it != last) {
+            if (self->m_index) {
+                cgcs_vector_index_move(self, vector_size(self) - 1,
+                                       vector_distance(self, self->m_impl.m_start, it));
+            }
+
+            cgcs_vector_base_assign(&(self->m_impl), it, last);
+        } else if (self->m_index) {
+            cgcs_vector_index_erase(self, vector_size(self) - 1, 1);
+        }
+
+        self->m_impl.m_finish = last;
     }
 
-    *(self->m_impl.m_finish++) = *(void **)(valaddr);
+    return it;
 }
 
 /*!
-    \brief
+    \brief      Erases the blocks at the n positions in idx, keeping
+                the others in order
+
+    The blocks between two erased positions are moved once, as a run,
+    so the whole call moves each surviving block at most once --
+    unlike calling vector_erase n times, which moves the tail every time.
 
     \param[in]  self
-    \param[in]  valaddr
-    \param[in]  allocfn
-    \param[in]  freefn
+    \param[in]  idx     strictly ascending, each less than vector_size(self)
+    \param[in]  n
 */
-void vector_push_back_alloc_free_fn(vector_t *self, const void *valaddr, 
-                             void *(*allocfn)(size_t), void (*freefn)(void *)) {
-    if (cgcs_vector_base_full_capacity(&(self->m_impl))) {
-        vector_resize_alloc_free_fn(self, vector_capacity(self) * 2, allocfn, freefn);
+void vector_erase_positions(vector_t *self, const size_t *idx, size_t n) {
+    const size_t elem_size = self->m_impl.m_elem_size;
+    const size_t size = vector_size(self);
+    char *dst = NULL;
+
+    if (n == 0) {
+        return;
+    }
+
+    dst = (char *)vector_advance(self, self->m_impl.m_start, idx[0]);
+
+    for (size_t k = 0; k < n; k++) {
+        const size_t first = idx[k] + 1;
+        const size_t last = k + 1 < n ? idx[k + 1] : size;
+
+        assert(idx[k] < size && first <= last);
+
+        memmove(dst, vector_advance(self, self->m_impl.m_start, first),
+                elem_size * (last - first));
+        dst += elem_size * (last - first);
     }
 
-    *(self->m_impl.m_finish++) = *(void **)(valaddr);
+    self->m_impl.m_finish = (voidptr *)dst;
+
+    // One rebuild, rather than a pass over the table per position.
+    vector_index_rebuild(self);
 }
 
 /*!
-    \brief
+    \brief      Erases the blocks at the n positions in idx in O(n),
+                by moving blocks from the back into the holes
+
+    The order of the blocks is not kept.
 
     \param[in]  self
+    \param[in]  idx     strictly ascending, each less than vector_size(self)
+    \param[in]  n
 */
-void vector_pop_back(vector_t *self) {
-    if (vector_empty(self) == false) {
-        // We simply move m_finish one block to the left.
-        --self->m_impl.m_finish;
+void vector_erase_positions_unordered(vector_t *self, const size_t *idx, size_t n) {
+    // From the back: every position after idx[k] is gone by then,
+    // so the last block is never one that is yet to be erased.
+    for (size_t k = n; k-- > 0;) {
+        assert(idx[k] < vector_size(self) && (k == 0 || idx[k - 1] < idx[k]));
+        vector_erase_unordered(self, vector_advance(self, self->m_impl.m_start, idx[k]));
     }
 }
 
 /*!
-    \brief
-
-    \param[in]  self
+    \struct
+    \brief      A predicate given as a function or as a block
 */
-void vector_clear(vector_t *self) {
-    memset(self->m_impl.m_start, '\0',
-           vector_size(self) * sizeof *self->m_impl.m_start);
-    self->m_impl.m_finish = self->m_impl.m_start;
+struct cgcs_vector_pred {
+    bool (*m_fn)(const void *);
+    bool (^m_b)(const void *);
+};
+
+static inline bool
+cgcs_vector_pred_test(const struct cgcs_vector_pred *pred, const void *block) {
+    return pred->m_fn ? pred->m_fn(block) : pred->m_b(block);
 }
 
 /*!
-    \brief
+    \enum
+    \brief      What cgcs_vector_compact does with the blocks it does not keep
+*/
+enum cgcs_vector_compact_mode {
+    CGCS_VECTOR_COMPACT_DROP,   // overwrite them (vector_remove_if)
+    CGCS_VECTOR_COMPACT_SWAP,   // swap them past the kept blocks (vector_partition)
+    CGCS_VECTOR_COMPACT_SPILL   // copy them out, then back after the kept blocks, in order
+                                // (vector_stable_partition)
+};
+
+/*!
+    \brief      Moves the blocks of [pos, end) for which pred returns keep
+                to the front of the range, in their order, in one pass
+
+    Blocks before the first one that is not kept are only tested, never
+    copied. The scratch memory (one block to SWAP; the rest of the range,
+    at most, to SPILL) is allocated from the vector's allocator.
 
     \param[in]  self
-    \param[in]  func
+    \param[in]  pos
+    \param[in]  end
+    \param[in]  pred
+    \param[in]  keep
+    \param[in]  mode
+
+    \return     iterator past the last kept block
 */
-void vector_foreach(vector_t *self, void (*func)(void *)) {
-    vector_iterator_t it = vector_begin(self);
-    vector_iterator_t end = vector_end(self);
+static vector_iterator_t
+cgcs_vector_compact(vector_t *self, vector_iterator_t pos, vector_iterator_t end,
+                    const struct cgcs_vector_pred *pred, bool keep,
+                    enum cgcs_vector_compact_mode mode) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    const size_t elem_size = self->m_impl.m_elem_size;
+    size_t scratch_size = 0;
+    char *scratch = NULL;
+    char *spill = NULL;
+    char *dst = (char *)pos;
+
+    while (dst < (char *)end && cgcs_vector_pred_test(pred, dst) == keep) {
+        dst += elem_size;
+    }
 
-    for (; it < end; it++) {
-        func(it);
+    if (dst == (char *)end) {
+        return end;
     }
-}
 
-void vector_foreach_b(vector_t *self, void (^block)(void *)) {
-    vector_iterator_t it = vector_begin(self);
+    if (mode == CGCS_VECTOR_COMPACT_SWAP) {
+        scratch_size = elem_size;
+    } else if (mode == CGCS_VECTOR_COMPACT_SPILL) {
+        scratch_size = (char *)end - dst;
+    }
+
+    if (scratch_size > 0) {
+        scratch = alloc->m_allocfn(alloc->m_ctx, scratch_size);
+        assert(scratch);
+    }
+
+    spill = scratch;
+
+    // The block at dst is the first one not kept.
+    if (mode == CGCS_VECTOR_COMPACT_SPILL) {
+        memcpy(spill, dst, elem_size);
+        spill += elem_size;
+    }
+
+    for (char *it = dst + elem_size; it < (char *)end; it += elem_size) {
+        if (cgcs_vector_pred_test(pred, it) == keep) {
+            if (mode == CGCS_VECTOR_COMPACT_SWAP) {
+                memcpy(scratch, dst, elem_size);
+                cgcs_vector_base_assign(&(self->m_impl), (voidptr *)dst, it);
+                memcpy(it, scratch, elem_size);
+            } else {
+                cgcs_vector_base_assign(&(self->m_impl), (voidptr *)dst, it);
+            }
+
+            dst += elem_size;
+        } else if (mode == CGCS_VECTOR_COMPACT_SPILL) {
+            memcpy(spill, it, elem_size);
+            spill += elem_size;
+        }
+    }
+
+    if (mode == CGCS_VECTOR_COMPACT_SPILL) {
+        memcpy(dst, scratch, spill - scratch);
+    }
+
+    if (scratch_size > 0) {
+        alloc->m_freefn(alloc->m_ctx, scratch, scratch_size);
+    }
+
+    return (vector_iterator_t)dst;
+}
+
+/*!
+    \brief      Erases every block for which predfn returns true,
+                keeping the others in order
+
+    One pass, each surviving block copied at most once -- unlike
+    calling vector_erase in a loop, which moves the tail every time.
+    predfn is given the address of each block, once, from front to back.
+    As with vector_erase, nothing is freed: predfn may release what a
+    block points to before returning true.
+
+    \param[in]  self
+    \param[in]  predfn
+
+    \return     the number of blocks erased
+*/
+size_t vector_remove_if(vector_t *self, bool (*predfn)(const void *)) {
+    const struct cgcs_vector_pred pred = { .m_fn = predfn, .m_b = NULL };
+    const size_t size = vector_size(self);
+
+    self->m_impl.m_finish = cgcs_vector_compact(self, vector_begin(self), vector_end(self),
+                                                &pred, false, CGCS_VECTOR_COMPACT_DROP);
+
+    if (vector_size(self) < size) {
+        vector_index_rebuild(self);
+    }
+
+    return size - vector_size(self);
+}
+
+size_t vector_remove_if_b(vector_t *self, bool (^pred_b)(const void *)) {
+    const struct cgcs_vector_pred pred = { .m_fn = NULL, .m_b = pred_b };
+    const size_t size = vector_size(self);
+
+    self->m_impl.m_finish = cgcs_vector_compact(self, vector_begin(self), vector_end(self),
+                                                &pred, false, CGCS_VECTOR_COMPACT_DROP);
+
+    if (vector_size(self) < size) {
+        vector_index_rebuild(self);
+    }
+
+    return size - vector_size(self);
+}
+
+/*!
+    \brief      Reorders self so that every block for which predfn returns
+                true precedes every block for which it returns false
+
+    In place, in one pass; the relative order of the blocks is not kept
+    (see vector_stable_partition).
+
+    \param[in]  self
+    \param[in]  predfn
+
+    \return     iterator to the first block for which predfn returns false
+                (vector_end(self) if there is none)
+*/
+vector_iterator_t vector_partition(vector_t *self, bool (*predfn)(const void *)) {
+    const struct cgcs_vector_pred pred = { .m_fn = predfn, .m_b = NULL };
+    vector_iterator_t mid = cgcs_vector_compact(self, vector_begin(self), vector_end(self),
+                                                &pred, true, CGCS_VECTOR_COMPACT_SWAP);
+
+    vector_index_rebuild(self);
+    return mid;
+}
+
+vector_iterator_t vector_partition_b(vector_t *self, bool (^pred_b)(const void *)) {
+    const struct cgcs_vector_pred pred = { .m_fn = NULL, .m_b = pred_b };
+    vector_iterator_t mid = cgcs_vector_compact(self, vector_begin(self), vector_end(self),
+                                                &pred, true, CGCS_VECTOR_COMPACT_SWAP);
+
+    vector_index_rebuild(self);
+    return mid;
+}
+
+/*!
+    \brief      vector_partition, keeping the relative order of the blocks
+                on both sides
+
+    One pass; the blocks for which predfn returns false are copied out
+    (into memory from the vector's allocator) and back.
+
+    \param[in]  self
+    \param[in]  predfn
+
+    \return     iterator to the first block for which predfn returns false
+                (vector_end(self) if there is none)
+*/
+vector_iterator_t vector_stable_partition(vector_t *self, bool (*predfn)(const void *)) {
+    const struct cgcs_vector_pred pred = { .m_fn = predfn, .m_b = NULL };
+    vector_iterator_t mid = cgcs_vector_compact(self, vector_begin(self), vector_end(self),
+                                                &pred, true, CGCS_VECTOR_COMPACT_SPILL);
+
+    vector_index_rebuild(self);
+    return mid;
+}
+
+vector_iterator_t vector_stable_partition_b(vector_t *self, bool (^pred_b)(const void *)) {
+    const struct cgcs_vector_pred pred = { .m_fn = NULL, .m_b = pred_b };
+    vector_iterator_t mid = cgcs_vector_compact(self, vector_begin(self), vector_end(self),
+                                                &pred, true, CGCS_VECTOR_COMPACT_SPILL);
+
+    vector_index_rebuild(self);
+    return mid;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  valaddr
+*/
+void vector_push_back(vector_t *self, const void *valaddr) {
+    if (cgcs_vector_base_full_capacity(&(self->m_impl))) {
+        cgcs_vector_grow(self, vector_size(self) + 1);
+    }
+
+    cgcs_vector_base_assign(&(self->m_impl), self->m_impl.m_finish, valaddr);
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, 1);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_size(self) - 1, 1);
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  valaddr
+    \param[in]  allocfn
+    \param[in]  freefn
+*/
+void vector_push_back_alloc_free_fn(vector_t *self, const void *valaddr, 
+                             void *(*allocfn)(size_t), void (*freefn)(void *)) {
+    if (cgcs_vector_base_full_capacity(&(self->m_impl))) {
+        cgcs_vector_grow_allocfreefn(self, vector_size(self) + 1, allocfn, freefn);
+    }
+
+    cgcs_vector_base_assign(&(self->m_impl), self->m_impl.m_finish, valaddr);
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, 1);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_size(self) - 1, 1);
+    }
+}
+
+/*!
+    \brief      Appends the n blocks addressed by src, growing (at most) once
+
+    For a vector made with vector_init, src is an array of n pointers.
+
+    \param[in]  self
+    \param[in]  src
+    \param[in]  n
+
+    \return     iterator to the first appended block
+*/
+vector_iterator_t vector_append_n(vector_t *self, const void *src, size_t n) {
+    vector_iterator_t it = vector_reserve_back(self, n);
+
+    memcpy(it, src, self->m_impl.m_elem_size * n);
+    self->m_impl.m_finish = vector_advance(self, it, n);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_size(self) - n, n);
+    }
+
+    return it;
+}
+
+/*!
+    \brief      Makes room for n more blocks, and returns where they begin
+
+    The caller may write up to n blocks starting at the returned iterator,
+    then makes them part of the vector with vector_commit_back.
+    Nothing in [vector_end(self), vector_end(self) + n) is read until then.
+
+    \code
+        vector_iterator_t out = vector_reserve_back(&vec, batch_size);
+        size_t written = 0;
+
+        while (written < batch_size && (out[written] = next_record())) {
+            ++written;
+        }
+
+        vector_commit_back(&vec, written);
+    \endcode
+
+    \param[in]  self
+    \param[in]  n
+
+    \return     iterator to the first writable block, i.e. vector_end(self)
+*/
+vector_iterator_t vector_reserve_back(vector_t *self, size_t n) {
+    const size_t required = vector_size(self) + n;
+
+    if (required > vector_capacity(self)) {
+        cgcs_vector_grow(self, required);
+    }
+
+    return self->m_impl.m_finish;
+}
+
+/*!
+    \brief      Appends the n blocks written past vector_end(self)
+                after a call to vector_reserve_back
+
+    \param[in]  self
+    \param[in]  n
+*/
+void vector_commit_back(vector_t *self, size_t n) {
+    assert(n <= (size_t)vector_distance(self, self->m_impl.m_finish,
+                                        self->m_impl.m_end_of_storage));
+
+    self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, n);
+
+    if (self->m_index) {
+        cgcs_vector_index_insert(self, vector_size(self) - n, n);
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_pop_back(vector_t *self) {
+    if (vector_empty(self) == false) {
+        if (self->m_index) {
+            cgcs_vector_index_erase(self, vector_size(self) - 1, 1);
+        }
+
+        // We simply move m_finish one block to the left.
+        self->m_impl.m_finish = vector_advance(self, self->m_impl.m_finish, -1);
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_clear(vector_t *self) {
+    if (self->m_fill == CGCS_VECTOR_FILL_ZERO) {
+        memset(self->m_impl.m_start, '\0',
+               (char *)self->m_impl.m_finish - (char *)self->m_impl.m_start);
+    }
+
+    self->m_impl.m_finish = self->m_impl.m_start;
+
+    if (self->m_index) {
+        cgcs_vector_index_clear(self);
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  func
+*/
+void vector_foreach(vector_t *self, void (*func)(void *)) {
+    vector_iterator_t it = vector_begin(self);
     vector_iterator_t end = vector_end(self);
 
-    for (; it < end; it++) {
+    for (; it < end; it = vector_advance(self, it, 1)) {
+        func(it);
+    }
+}
+
+void vector_foreach_b(vector_t *self, void (^block)(void *)) {
+    vector_iterator_t it = vector_begin(self);
+    vector_iterator_t end = vector_end(self);
+
+    for (; it < end; it = vector_advance(self, it, 1)) {
         block(it);
     }
 }
@@ -533,26 +1377,26 @@ int vector_search(vector_t *self, int (*cmpfn)(const void *, const void *),
     vector_iterator_t it = vector_begin(self);
     vector_iterator_t end = vector_end(self);
 
-    for (; it < end; it++) {
+    for (; it < end; it = vector_advance(self, it, 1)) {
         if (cmpfn(it, valaddr) == 0) {
             break;
         }
     }
 
-    return it == end ? (-1) : (int)(end - it);
+    return it == end ? (-1) : (int)vector_distance(self, vector_begin(self), it);
 }
 
 int vector_search_b(vector_t *self, int (^cmp_b)(const void *, const void *), const void *valaddr) {
     vector_iterator_t it = vector_begin(self);
     vector_iterator_t end = vector_end(self);
 
-    for (; it < end; it++) {
+    for (; it < end; it = vector_advance(self, it, 1)) {
         if (cmp_b(it, valaddr) == 0) {
             break;
         }
     }
 
-    return it == end ? (-1) : (int)(end - it); 
+    return it == end ? (-1) : (int)vector_distance(self, vector_begin(self), it);
 }
 
 /*!
@@ -568,30 +1412,26 @@ int vector_search_b(vector_t *self, int (^cmp_b)(const void *, const void *), co
 */
 int vector_search_range(vector_t *self, int (*cmpfn)(const void *, const void *),
                       const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
-    vector_iterator_t self_end = vector_end(self);
-
-    for (; beg < end; beg++) {
-        if (cmpfn(beg++, valaddr) == 0) {
+    for (; beg < end; beg = vector_advance(self, beg, 1)) {
+        if (cmpfn(beg, valaddr) == 0) {
             break;
         }
     }
 
-    return (beg == end) ? -1 : (int)(self_end - beg);
+    return (beg == end) ? -1 : (int)vector_distance(self, vector_begin(self), beg);
 }
 
 int vector_search_range_b(vector_t *self,
                        int (^cmp_b)(const void *, const void *),
                        const void *valaddr, vector_iterator_t beg,
                        vector_iterator_t end) {
-    vector_iterator_t self_end = vector_end(self);
-
-    for (; beg < end; beg++) {
-        if (cmp_b(beg++, valaddr) == 0) {
+    for (; beg < end; beg = vector_advance(self, beg, 1)) {
+        if (cmp_b(beg, valaddr) == 0) {
             break;
         }
     }
 
-    return (beg == end) ? -1 : (int)(self_end - beg);
+    return (beg == end) ? -1 : (int)vector_distance(self, vector_begin(self), beg);
 }
 
 /*!
@@ -608,7 +1448,7 @@ vector_iterator_t vector_find(vector_t *self, int (*cmpfn)(const void *, const v
     vector_iterator_t it = vector_begin(self);
     vector_iterator_t end = vector_end(self);
 
-    for (; it < end; it++) {
+    for (; it < end; it = vector_advance(self, it, 1)) {
         if (cmpfn(it, valaddr) == 0) {
             break;
         }
@@ -623,7 +1463,7 @@ vector_iterator_t vector_find_b(vector_t *self,
     vector_iterator_t it = vector_begin(self);
     vector_iterator_t end = vector_end(self);
 
-    for (; it < end; it++) {
+    for (; it < end; it = vector_advance(self, it, 1)) {
         if (cmp_b(it, valaddr) == 0) {
             break;
         }
@@ -647,7 +1487,7 @@ vector_iterator_t vector_find_range(vector_t *self,
                             int (*cmpfn)(const void *, const void *),
                             const void *valaddr, vector_iterator_t beg,
                             vector_iterator_t end) {
-    for (; beg < end; beg++) {
+    for (; beg < end; beg = vector_advance(self, beg, 1)) {
         if (cmpfn(beg, valaddr) == 0) {
             break;
         }
@@ -660,7 +1500,7 @@ vector_iterator_t vector_find_range_b(vector_t *self,
                                       int (^cmp_b)(const void *, const void *),
                                       const void *valaddr, vector_iterator_t beg,
                                       vector_iterator_t end) {
-    for (; beg < end; beg++) {
+    for (; beg < end; beg = vector_advance(self, beg, 1)) {
         if (cmp_b(beg, valaddr) == 0) {
             break;
         }
@@ -669,6 +1509,308 @@ vector_iterator_t vector_find_range_b(vector_t *self,
     return (beg == end) ? NULL : beg;
 }
 
+/*!
+    \brief      Returns the first block in a sorted vector
+                that does not compare less than *valaddr
+
+    Requires [vector_begin(self), vector_end(self)) to be sorted by cmpfn.
+    O(log n) comparisons.
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  valaddr
+
+    \return     iterator to the first block not less than *valaddr,
+                or vector_end(self) (end, for the range variant)
+*/
+vector_iterator_t vector_lower_bound(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr) {
+    return vector_lower_bound_range(self, cmpfn, valaddr, vector_begin(self), vector_end(self));
+}
+
+vector_iterator_t vector_lower_bound_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr) {
+    return vector_lower_bound_range_b(self, cmp_b, valaddr, vector_begin(self), vector_end(self));
+}
+
+vector_iterator_t vector_lower_bound_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
+    // Each step halves n, and moves beg up to the middle block
+    // (without a branch) if that block is still less than *valaddr.
+    size_t n = vector_distance(self, beg, end);
+
+    while (n > 1) {
+        const size_t half = n / 2;
+        vector_iterator_t mid = vector_advance(self, beg, half);
+
+        beg = (cmpfn(mid, valaddr) < 0) ? mid : beg;
+        n -= half;
+    }
+
+    return (n == 1 && cmpfn(beg, valaddr) < 0) ? vector_advance(self, beg, 1) : beg;
+}
+
+vector_iterator_t vector_lower_bound_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
+    // Each step halves n, and moves beg up to the middle block
+    // (without a branch) if that block is still less than *valaddr.
+    size_t n = vector_distance(self, beg, end);
+
+    while (n > 1) {
+        const size_t half = n / 2;
+        vector_iterator_t mid = vector_advance(self, beg, half);
+
+        beg = (cmp_b(mid, valaddr) < 0) ? mid : beg;
+        n -= half;
+    }
+
+    return (n == 1 && cmp_b(beg, valaddr) < 0) ? vector_advance(self, beg, 1) : beg;
+}
+
+/*!
+    \brief      Returns the first block in a sorted vector
+                that compares greater than *valaddr
+
+    Requires [vector_begin(self), vector_end(self)) to be sorted by cmpfn.
+    O(log n) comparisons.
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  valaddr
+
+    \return     iterator to the first block greater than *valaddr,
+                or vector_end(self) (end, for the range variant)
+*/
+vector_iterator_t vector_upper_bound(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr) {
+    return vector_upper_bound_range(self, cmpfn, valaddr, vector_begin(self), vector_end(self));
+}
+
+vector_iterator_t vector_upper_bound_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr) {
+    return vector_upper_bound_range_b(self, cmp_b, valaddr, vector_begin(self), vector_end(self));
+}
+
+vector_iterator_t vector_upper_bound_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
+    size_t n = vector_distance(self, beg, end);
+
+    while (n > 1) {
+        const size_t half = n / 2;
+        vector_iterator_t mid = vector_advance(self, beg, half);
+
+        beg = (cmpfn(mid, valaddr) <= 0) ? mid : beg;
+        n -= half;
+    }
+
+    return (n == 1 && cmpfn(beg, valaddr) <= 0) ? vector_advance(self, beg, 1) : beg;
+}
+
+vector_iterator_t vector_upper_bound_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
+    size_t n = vector_distance(self, beg, end);
+
+    while (n > 1) {
+        const size_t half = n / 2;
+        vector_iterator_t mid = vector_advance(self, beg, half);
+
+        beg = (cmp_b(mid, valaddr) <= 0) ? mid : beg;
+        n -= half;
+    }
+
+    return (n == 1 && cmp_b(beg, valaddr) <= 0) ? vector_advance(self, beg, 1) : beg;
+}
+
+/*!
+    \brief      Finds the run of blocks in a sorted vector
+                that compare equal to *valaddr
+
+    Requires [vector_begin(self), vector_end(self)) to be sorted by cmpfn.
+    O(log n) comparisons.
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  valaddr
+    \param[out] last
+
+    \return     iterator to the first block of the run; *last is set to
+                one-past its last block (both equal the insertion point
+                if no block compares equal)
+*/
+vector_iterator_t vector_equal_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t *last) {
+    return vector_equal_range_range(self, cmpfn, valaddr, vector_begin(self), vector_end(self), last);
+}
+
+vector_iterator_t vector_equal_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t *last) {
+    return vector_equal_range_range_b(self, cmp_b, valaddr, vector_begin(self), vector_end(self), last);
+}
+
+vector_iterator_t vector_equal_range_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end, vector_iterator_t *last) {
+    vector_iterator_t first = vector_lower_bound_range(self, cmpfn, valaddr, beg, end);
+
+    // The run cannot begin before first.
+    *last = vector_upper_bound_range(self, cmpfn, valaddr, first, end);
+    return first;
+}
+
+vector_iterator_t vector_equal_range_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end, vector_iterator_t *last) {
+    vector_iterator_t first = vector_lower_bound_range_b(self, cmp_b, valaddr, beg, end);
+
+    // The run cannot begin before first.
+    *last = vector_upper_bound_range_b(self, cmp_b, valaddr, first, end);
+    return first;
+}
+
+/*!
+    \brief      Binary search for a block equal to *valaddr
+                in a sorted vector
+
+    Requires [vector_begin(self), vector_end(self)) to be sorted by cmpfn.
+    O(log n) comparisons.
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  valaddr
+
+    \return     iterator to a matching block, or NULL if there is none
+                (like vector_find)
+*/
+vector_iterator_t vector_bsearch(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr) {
+    return vector_bsearch_range(self, cmpfn, valaddr, vector_begin(self), vector_end(self));
+}
+
+vector_iterator_t vector_bsearch_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr) {
+    return vector_bsearch_range_b(self, cmp_b, valaddr, vector_begin(self), vector_end(self));
+}
+
+vector_iterator_t vector_bsearch_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
+    vector_iterator_t it = vector_lower_bound_range(self, cmpfn, valaddr, beg, end);
+
+    return (it < end && cmpfn(it, valaddr) == 0) ? it : NULL;
+}
+
+vector_iterator_t vector_bsearch_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end) {
+    vector_iterator_t it = vector_lower_bound_range_b(self, cmp_b, valaddr, beg, end);
+
+    return (it < end && cmp_b(it, valaddr) == 0) ? it : NULL;
+}
+
+/*!
+    \brief      Returns the bytes needed by cgcs_vector_indirect_new
+
+    \param[in]  self
+    \param[in]  n
+    \param[in]  scratch_n
+
+    \return
+*/
+static inline size_t
+cgcs_vector_indirect_size(vector_t *self, size_t n, size_t scratch_n) {
+    return sizeof(voidptr) * (n + scratch_n) + self->m_impl.m_elem_size;
+}
+
+/*!
+    \brief      Prepares to sort n elem_size-wide blocks starting at pos
+                by sorting their addresses instead
+
+    Returns an array of the n addresses, followed by scratch_n spare slots
+    (for name_mergesort) and room for one block (for the permutation
+    done by cgcs_vector_indirect_delete).
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  n
+    \param[in]  scratch_n
+
+    \return
+*/
+static voidptr *
+cgcs_vector_indirect_new(vector_t *self, vector_iterator_t pos, size_t n, size_t scratch_n) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    voidptr *addrs = alloc->m_allocfn(alloc->m_ctx, cgcs_vector_indirect_size(self, n, scratch_n));
+    assert(addrs);
+
+    for (size_t i = 0; i < n; i++) {
+        addrs[i] = vector_advance(self, pos, i);
+    }
+
+    return addrs;
+}
+
+/*!
+    \brief      Moves the blocks starting at pos into the order given by
+                the (sorted) addresses in addrs, then frees addrs
+
+    Each cycle of the permutation is followed once,
+    so every block is copied exactly once (plus one copy per cycle).
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  addrs
+    \param[in]  n
+    \param[in]  scratch_n
+*/
+static void
+cgcs_vector_indirect_delete(vector_t *self, vector_iterator_t pos, voidptr *addrs,
+                            size_t n, size_t scratch_n) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    const size_t elem_size = self->m_impl.m_elem_size;
+    char *tmp = (char *)(addrs + n + scratch_n);
+
+    for (size_t i = 0; i < n; i++) {
+        char *hole = (char *)vector_advance(self, pos, i);
+        size_t j = i;
+
+        if (addrs[i] == hole) {
+            continue;
+        }
+
+        // Block i is saved, leaving a hole; addrs[j] names the block
+        // that belongs in the hole at j, which leaves a hole where it was.
+        memcpy(tmp, hole, elem_size);
+
+        for (;;) {
+            char *src = addrs[j];
+            const size_t k = vector_distance(self, pos, (vector_iterator_t)src);
+
+            // Marks position j as done.
+            addrs[j] = hole;
+
+            if (k == i) {
+                memcpy(hole, tmp, elem_size);
+                break;
+            }
+
+            memcpy(hole, src, elem_size);
+            hole = src;
+            j = k;
+        }
+    }
+
+    alloc->m_freefn(alloc->m_ctx, addrs, cgcs_vector_indirect_size(self, n, scratch_n));
+}
+
+/*!
+    \brief      Returns true if self stores pointers (vector_init),
+                so its blocks can be sorted in place as voidptr
+
+    \param[in]  self
+
+    \return
+*/
+static inline bool
+cgcs_vector_sort_direct(vector_t *self) {
+    return self->m_impl.m_elem_size == sizeof(voidptr);
+}
+
 /*!
     \brief
 
@@ -676,85 +1818,263 @@ vector_iterator_t vector_find_range_b(vector_t *self,
     \param[in]  cmpfn
 */
 void vector_qsort(vector_t *self, int (*cmpfn)(const void *, const void *)) {
-    qsort(self->m_impl.m_start,
-          vector_size(self),
-          sizeof *self->m_impl.m_start,
-          cmpfn);
+    vector_qsort_range(self, cmpfn, vector_begin(self), vector_end(self));
 }
 
 void vector_qsort_b(vector_t *self,
                  int (^cmp_b)(const void *, const void *)) {
-    qsort_b(self->m_impl.m_start,
-          vector_size(self),
-          sizeof *self->m_impl.m_start,
-          cmp_b);
+    vector_qsort_range_b(self, cmp_b, vector_begin(self), vector_end(self));
 }
 
 /*!
-    \brief
+    \brief      Sorts [pos, end) with pattern-defeating quicksort (unstable)
 
     \param[in]  self
     \param[in]  cmpfn
     \param[in]  pos
+    \param[in]  end
 */
 void vector_qsort_range(vector_t *self,
                           int (*cmpfn)(const void *, const void *),
                           vector_iterator_t pos, vector_iterator_t end) {
-    qsort(pos,
-          end - pos,
-          sizeof *self->m_impl.m_start,
-          cmpfn);
+    if (cgcs_vector_sort_direct(self)) {
+        cgcs_vector_sort_fn_pdqsort(pos, end, cmpfn);
+    } else {
+        const size_t n = vector_distance(self, pos, end);
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, 0);
+
+        cgcs_vector_sort_indirect_fn_pdqsort(addrs, addrs + n, cmpfn);
+        cgcs_vector_indirect_delete(self, pos, addrs, n, 0);
+    }
+
+    vector_index_rebuild(self);
 }
 
 void vector_qsort_range_b(vector_t *self,
                           int (^cmp_b)(const void *, const void *),
                           vector_iterator_t pos, vector_iterator_t end) {
-    qsort_b(pos,
-          end - pos,
-          sizeof *self->m_impl.m_start,
-          cmp_b);
+    if (cgcs_vector_sort_direct(self)) {
+        cgcs_vector_sort_b_pdqsort(pos, end, cmp_b);
+    } else {
+        const size_t n = vector_distance(self, pos, end);
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, 0);
+
+        cgcs_vector_sort_indirect_b_pdqsort(addrs, addrs + n, cmp_b);
+        cgcs_vector_indirect_delete(self, pos, addrs, n, 0);
+    }
+
+    vector_index_rebuild(self);
 }
 
 void vector_mergesort(vector_t *self, int (*cmpfn)(const void *, const void *)) {
-    mergesort(self->m_impl.m_start, vector_size(self), sizeof *self->m_impl.m_start, cmpfn);
+    vector_mergesort_range(self, cmpfn, vector_begin(self), vector_end(self));
 }
 
 void vector_mergesort_b(vector_t *self, int (^cmp_b)(const void *, const void *)) {
-    mergesort_b(self->m_impl.m_start, vector_size(self), sizeof *self->m_impl.m_start, cmp_b);
+    vector_mergesort_range_b(self, cmp_b, vector_begin(self), vector_end(self));
 }
 
+/*!
+    \brief      Sorts [pos, end) with a stable merge sort
+
+    One scratch buffer, half the length of the range,
+    is allocated (from the vector's allocator) and reused by every merge.
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  pos
+    \param[in]  end
+*/
 void vector_mergesort_range(vector_t *self, int (*cmpfn)(const void *, const void *), vector_iterator_t pos, vector_iterator_t end) {
-    mergesort(pos,
-          end - pos,
-          sizeof *self->m_impl.m_start,
-          cmpfn); 
+    const size_t n = vector_distance(self, pos, end);
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+
+    if (cgcs_vector_sort_direct(self)) {
+        voidptr *scratch = alloc->m_allocfn(alloc->m_ctx, sizeof *scratch * (n / 2));
+        assert(scratch || n / 2 == 0);
+
+        cgcs_vector_sort_fn_mergesort(pos, end, scratch, cmpfn);
+        alloc->m_freefn(alloc->m_ctx, scratch, sizeof *scratch * (n / 2));
+    } else {
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, n / 2);
+
+        cgcs_vector_sort_indirect_fn_mergesort(addrs, addrs + n, addrs + n, cmpfn);
+        cgcs_vector_indirect_delete(self, pos, addrs, n, n / 2);
+    }
+
+    vector_index_rebuild(self);
 }
 
 void vector_mergesort_range_b(vector_t *self, int (^cmp_b)(const void *, const void *), vector_iterator_t pos, vector_iterator_t end) {
-    mergesort_b(pos,
-          end - pos,
-          sizeof *self->m_impl.m_start,
-          cmp_b);
+    const size_t n = vector_distance(self, pos, end);
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+
+    if (cgcs_vector_sort_direct(self)) {
+        voidptr *scratch = alloc->m_allocfn(alloc->m_ctx, sizeof *scratch * (n / 2));
+        assert(scratch || n / 2 == 0);
+
+        cgcs_vector_sort_b_mergesort(pos, end, scratch, cmp_b);
+        alloc->m_freefn(alloc->m_ctx, scratch, sizeof *scratch * (n / 2));
+    } else {
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, n / 2);
+
+        cgcs_vector_sort_indirect_b_mergesort(addrs, addrs + n, addrs + n, cmp_b);
+        cgcs_vector_indirect_delete(self, pos, addrs, n, n / 2);
+    }
+
+    vector_index_rebuild(self);
 }
 
 void vector_heapsort(vector_t *self, int (*cmpfn)(const void *, const void *)) {
-    heapsort(self->m_impl.m_start, vector_size(self), sizeof *self->m_impl.m_start, cmpfn);    
+    vector_heapsort_range(self, cmpfn, vector_begin(self), vector_end(self));
 }
 
 void vector_heapsort_b(vector_t *self, int (^cmp_b)(const void *, const void *)) {
-    heapsort_b(self->m_impl.m_start, vector_size(self), sizeof *self->m_impl.m_start, cmp_b);
+    vector_heapsort_range_b(self, cmp_b, vector_begin(self), vector_end(self));
 }
 
+/*!
+    \brief      Sorts [pos, end) with heapsort (unstable, no extra memory
+                for vectors made with vector_init)
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  pos
+    \param[in]  end
+*/
 void vector_heapsort_range(vector_t *self, int (*cmpfn)(const void *, const void *), vector_iterator_t pos, vector_iterator_t end) {
-    heapsort(pos,
-          end - pos,
-          sizeof *self->m_impl.m_start,
-          cmpfn); 
+    if (cgcs_vector_sort_direct(self)) {
+        cgcs_vector_sort_fn_heapsort(pos, end, cmpfn);
+    } else {
+        const size_t n = vector_distance(self, pos, end);
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, 0);
+
+        cgcs_vector_sort_indirect_fn_heapsort(addrs, addrs + n, cmpfn);
+        cgcs_vector_indirect_delete(self, pos, addrs, n, 0);
+    }
+
+    vector_index_rebuild(self);
 }
 
 void vector_heapsort_range_b(vector_t *self, int (^cmp_b)(const void *, const void *), vector_iterator_t pos, vector_iterator_t end) {
-    heapsort_b(pos,
-          end - pos,
-          sizeof *self->m_impl.m_start,
-          cmp_b);
+    if (cgcs_vector_sort_direct(self)) {
+        cgcs_vector_sort_b_heapsort(pos, end, cmp_b);
+    } else {
+        const size_t n = vector_distance(self, pos, end);
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, 0);
+
+        cgcs_vector_sort_indirect_b_heapsort(addrs, addrs + n, cmp_b);
+        cgcs_vector_indirect_delete(self, pos, addrs, n, 0);
+    }
+
+    vector_index_rebuild(self);
+}
+
+/*!
+    \brief      Allocates room for the keys of n blocks,
+                plus as many again for cgcs_vector_radix_sort to use
+
+    \param[in]  self
+    \param[in]  n
+
+    \return
+*/
+static struct cgcs_vector_radix_item *
+cgcs_vector_radix_new(vector_t *self, size_t n) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    struct cgcs_vector_radix_item *items = alloc->m_allocfn(alloc->m_ctx, sizeof *items * n * 2);
+    assert(items || n == 0);
+
+    return items;
+}
+
+/*!
+    \brief      Sorts the n blocks starting at pos by the keys in items,
+                then frees items
+
+    For vectors made with vector_init, items hold the blocks themselves,
+    and are copied back in order; otherwise they hold block addresses,
+    and the blocks are permuted as by the comparison sorts.
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  items
+    \param[in]  n
+*/
+static void
+cgcs_vector_radix_delete(vector_t *self, vector_iterator_t pos,
+                         struct cgcs_vector_radix_item *items, size_t n) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    struct cgcs_vector_radix_item *sorted = cgcs_vector_radix_sort(items, items + n, n);
+
+    if (cgcs_vector_sort_direct(self)) {
+        for (size_t i = 0; i < n; i++) {
+            pos[i] = sorted[i].m_ptr;
+        }
+    } else {
+        voidptr *addrs = cgcs_vector_indirect_new(self, pos, n, 0);
+
+        for (size_t i = 0; i < n; i++) {
+            addrs[i] = sorted[i].m_ptr;
+        }
+
+        cgcs_vector_indirect_delete(self, pos, addrs, n, 0);
+    }
+
+    alloc->m_freefn(alloc->m_ctx, items, sizeof *items * n * 2);
+}
+
+void vector_radix_sort_by_key(vector_t *self, uint64_t (*keyfn)(const void *)) {
+    vector_radix_sort_by_key_range(self, keyfn, vector_begin(self), vector_end(self));
+}
+
+void vector_radix_sort_by_key_b(vector_t *self, uint64_t (^key_b)(const void *)) {
+    vector_radix_sort_by_key_range_b(self, key_b, vector_begin(self), vector_end(self));
+}
+
+/*!
+    \brief      Sorts [pos, end) by an unsigned 64-bit key (stable)
+
+    keyfn is called once per block, with the block's address
+    (the same argument a comparator would get), and must return its key.
+    The sort is LSD radix, one byte per pass; passes over bytes that
+    are equal in every key are skipped.
+
+    \param[in]  self
+    \param[in]  keyfn
+    \param[in]  pos
+    \param[in]  end
+*/
+void vector_radix_sort_by_key_range(vector_t *self, uint64_t (*keyfn)(const void *), vector_iterator_t pos, vector_iterator_t end) {
+    const size_t n = vector_distance(self, pos, end);
+    const bool direct = cgcs_vector_sort_direct(self);
+    struct cgcs_vector_radix_item *items = cgcs_vector_radix_new(self, n);
+
+    for (size_t i = 0; i < n; i++) {
+        vector_iterator_t it = vector_advance(self, pos, i);
+
+        items[i].m_key = keyfn(it);
+        items[i].m_ptr = direct ? *it : it;
+    }
+
+    cgcs_vector_radix_delete(self, pos, items, n);
+
+    vector_index_rebuild(self);
+}
+
+void vector_radix_sort_by_key_range_b(vector_t *self, uint64_t (^key_b)(const void *), vector_iterator_t pos, vector_iterator_t end) {
+    const size_t n = vector_distance(self, pos, end);
+    const bool direct = cgcs_vector_sort_direct(self);
+    struct cgcs_vector_radix_item *items = cgcs_vector_radix_new(self, n);
+
+    for (size_t i = 0; i < n; i++) {
+        vector_iterator_t it = vector_advance(self, pos, i);
+
+        items[i].m_key = key_b(it);
+        items[i].m_ptr = direct ? *it : it;
+    }
+
+    cgcs_vector_radix_delete(self, pos, items, n);
+
+    vector_index_rebuild(self);
 }
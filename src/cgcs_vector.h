@@ -11,6 +11,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 // TODO: Fill in all documentation stubs
@@ -33,6 +34,65 @@ typedef void *voidptr;
 */
 typedef voidptr *vector_iterator_t;
 
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_allocator vector_allocator_t;
+
+/*!
+    \struct
+    \brief      Allocator a vector_t draws its buffer from
+
+    Chosen once, at init (see vector_init_allocator), and used by every
+    path that allocates, grows, shrinks or frees the vector's buffer.
+    m_ctx is passed back to each function untouched, so allocators
+    with state (arenas, pools) need no globals.
+
+    Sizes are in bytes. old_size/size are the size of the block
+    as it was allocated, which allows for sized deallocation.
+
+    m_reallocfn may be NULL, in which case the vector allocates a new block,
+    copies over its elements and frees the old block.
+*/
+struct cgcs_vector_allocator {
+    void *(*m_allocfn)(void *ctx, size_t size);
+    void *(*m_reallocfn)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    void (*m_freefn)(void *ctx, void *ptr, size_t size);
+    void *m_ctx;
+};
+
+/*!
+    \brief      The allocator used by vector_init -- malloc, realloc and free
+*/
+extern const vector_allocator_t cgcs_vector_malloc_allocator;
+
+/*!
+    \enum
+    \brief      How a vector_t computes its next capacity once it is full
+
+    Whichever policy is chosen, a vector always grows to at least
+    the capacity an operation requires (i.e. vector_insert_range).
+*/
+enum cgcs_vector_growth {
+    CGCS_VECTOR_GROWTH_FACTOR_2 = 0,    // capacity * 2 (default)
+    CGCS_VECTOR_GROWTH_FACTOR_1_5,      // capacity + capacity / 2
+    CGCS_VECTOR_GROWTH_ADDITIVE,        // capacity + increment
+    CGCS_VECTOR_GROWTH_USABLE_SIZE      // capacity * 2, rounded up to malloc's usable size
+};
+
+/*!
+    \enum
+    \brief      Whether a vector_t zeroes storage it is not using
+
+    No operation reads the slots past vector_end, so zeroing them only
+    matters to code that reads them through a raw pointer.
+*/
+enum cgcs_vector_fill {
+    CGCS_VECTOR_FILL_ZERO = 0,      // zero the buffer at init, and the blocks vector_clear drops (default)
+    CGCS_VECTOR_FILL_NONE           // leave both as they are
+};
+
 /*!
     \struct
     \brief
@@ -46,14 +106,83 @@ struct cgcs_vector {
         voidptr *m_start;
         voidptr *m_finish;
         voidptr *m_end_of_storage;
+
+        // Width of one block, in bytes.
+        // sizeof(voidptr) unless the vector was made with vector_init_elem.
+        size_t m_elem_size;
+
+        // Caller-owned inline storage given to vector_init_small, or NULL.
+        // While m_start == m_inline, the buffer is never realloc'd or freed.
+        voidptr *m_inline;
+
+        // Never NULL once initialized.
+        const vector_allocator_t *m_alloc;
     } m_impl;
+
+    // See vector_set_growth.
+    enum cgcs_vector_growth m_growth;
+    size_t m_growth_increment;
+
+    // See vector_set_fill.
+    enum cgcs_vector_fill m_fill;
+
+    // See vector_index_attach (cgcs_vector_index.h); NULL if not indexed.
+    struct cgcs_vector_index *m_index;
 };
 
+/*!
+    \brief      Declares a struct holding a vector_t and inline storage
+                for capacity pointers
+
+    A vector_t initialized with CGCS_VECTOR_SMALL_INIT uses m_buf
+    until it outgrows it, and only then moves its elements to the heap.
+    Because m_impl addresses m_buf, the enclosing struct must not be
+    copied or moved while the vector is in use.
+
+    \code
+        typedef CGCS_VECTOR_SMALL(8) small_vector_t;
+
+        small_vector_t sv;
+        CGCS_VECTOR_SMALL_INIT(&sv);
+
+        vector_push_back(&sv.m_vec, &str);  // no heap allocation yet
+        vector_deinit(&sv.m_vec);
+    \endcode
+*/
+#define CGCS_VECTOR_SMALL(capacity)                                            \
+    struct {                                                                   \
+        vector_t m_vec;                                                        \
+        voidptr m_buf[(capacity)];                                             \
+    }
+
+#define CGCS_VECTOR_SMALL_INIT(small)                                          \
+    vector_init_small(&(small)->m_vec, (small)->m_buf,                         \
+                      sizeof((small)->m_buf) / sizeof *((small)->m_buf))
+
 void vector_init(vector_t *self, size_t capacity);
 
 void vector_init_alloc_fn(vector_t *self, size_t capacity, 
                         void *(*allocfn)(size_t));
 
+void vector_init_elem(vector_t *self, size_t capacity, size_t elem_size);
+void vector_init_elem_alloc_fn(vector_t *self, size_t capacity, size_t elem_size,
+                             void *(*allocfn)(size_t));
+void vector_init_elem_alloc_fn_fill(vector_t *self, size_t capacity, size_t elem_size,
+                                   void *(*allocfn)(size_t), enum cgcs_vector_fill fill);
+
+void vector_init_allocator(vector_t *self, size_t capacity,
+                           const vector_allocator_t *alloc);
+void vector_init_elem_allocator(vector_t *self, size_t capacity, size_t elem_size,
+                                const vector_allocator_t *alloc);
+void vector_init_elem_allocator_fill(vector_t *self, size_t capacity, size_t elem_size,
+                                     const vector_allocator_t *alloc, enum cgcs_vector_fill fill);
+
+void vector_init_small(vector_t *self, voidptr *buf, size_t capacity);
+void vector_init_small_elem(vector_t *self, void *buf, size_t capacity, size_t elem_size);
+
+void vector_set_growth(vector_t *self, enum cgcs_vector_growth growth, size_t increment);
+void vector_set_fill(vector_t *self, enum cgcs_vector_fill fill);
+
 void vector_deinit(vector_t *self);
 void vector_deinit_free_fn(vector_t *self, void (*freefn)(void *));
 
@@ -65,6 +194,7 @@ static voidptr vector_i(vector_t *self, size_t index);
 static bool vector_empty(vector_t *self);
 static size_t vector_size(vector_t *self);
 static size_t vector_capacity(vector_t *self);
+static size_t vector_elem_size(vector_t *self);
 
 bool vector_resize(vector_t *self, size_t n);
 bool vector_resize_alloc_free_fn(vector_t *self, size_t n, 
@@ -77,6 +207,9 @@ bool vector_shrink_to_fit_alloc_free_fn(vector_t *self,
 static vector_iterator_t vector_begin(vector_t *self);
 static vector_iterator_t vector_end(vector_t *self);
 
+static vector_iterator_t vector_advance(vector_t *self, vector_iterator_t it, ptrdiff_t n);
+static ptrdiff_t vector_distance(vector_t *self, vector_iterator_t beg, vector_iterator_t end);
+
 vector_iterator_t vector_insert(vector_t *self, vector_iterator_t it,
                                   const void *valaddr);
 vector_iterator_t vector_insert_alloc_free_fn(vector_t *self, vector_iterator_t it,
@@ -97,10 +230,29 @@ vector_iterator_t vector_erase(vector_t *self, vector_iterator_t it);
 vector_iterator_t vector_erase_range(vector_t *self, vector_iterator_t beg,
                                        vector_iterator_t end);
 
+vector_iterator_t vector_erase_unordered(vector_t *self, vector_iterator_t it);
+
+void vector_erase_positions(vector_t *self, const size_t *idx, size_t n);
+void vector_erase_positions_unordered(vector_t *self, const size_t *idx, size_t n);
+
+size_t vector_remove_if(vector_t *self, bool (*predfn)(const void *));
+size_t vector_remove_if_b(vector_t *self, bool (^pred_b)(const void *));
+
+vector_iterator_t vector_partition(vector_t *self, bool (*predfn)(const void *));
+vector_iterator_t vector_partition_b(vector_t *self, bool (^pred_b)(const void *));
+
+vector_iterator_t vector_stable_partition(vector_t *self, bool (*predfn)(const void *));
+vector_iterator_t vector_stable_partition_b(vector_t *self, bool (^pred_b)(const void *));
+
 void vector_push_back(vector_t *self, const void *valaddr);
 void vector_push_back_alloc_free_fn(vector_t *self, const void *valaddr, 
                              void *(*allocfn)(size_t), void (*freefn)(void *));
 
+vector_iterator_t vector_append_n(vector_t *self, const void *src, size_t n);
+
+vector_iterator_t vector_reserve_back(vector_t *self, size_t n);
+void vector_commit_back(vector_t *self, size_t n);
+
 void vector_pop_back(vector_t *self);
 
 void vector_clear(vector_t *self);
@@ -143,6 +295,50 @@ vector_iterator_t vector_find_range_b(vector_t *self,
                                       const void *valaddr, vector_iterator_t beg,
                                       vector_iterator_t end);
 
+vector_iterator_t vector_find_ptr(vector_t *self, const void *ptr);
+vector_iterator_t vector_find_ptr_range(vector_t *self, const void *ptr,
+                                        vector_iterator_t beg, vector_iterator_t end);
+
+size_t vector_count_ptr(vector_t *self, const void *ptr);
+size_t vector_count_ptr_range(vector_t *self, const void *ptr,
+                              vector_iterator_t beg, vector_iterator_t end);
+
+vector_iterator_t vector_lower_bound(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr);
+vector_iterator_t vector_lower_bound_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr);
+vector_iterator_t vector_lower_bound_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end);
+vector_iterator_t vector_lower_bound_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end);
+
+vector_iterator_t vector_upper_bound(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr);
+vector_iterator_t vector_upper_bound_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr);
+vector_iterator_t vector_upper_bound_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end);
+vector_iterator_t vector_upper_bound_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end);
+
+vector_iterator_t vector_equal_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t *last);
+vector_iterator_t vector_equal_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t *last);
+vector_iterator_t vector_equal_range_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end, vector_iterator_t *last);
+vector_iterator_t vector_equal_range_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end, vector_iterator_t *last);
+
+vector_iterator_t vector_bsearch(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr);
+vector_iterator_t vector_bsearch_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr);
+vector_iterator_t vector_bsearch_range(vector_t *self, int (*cmpfn)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end);
+vector_iterator_t vector_bsearch_range_b(vector_t *self, int (^cmp_b)(const void *, const void *),
+        const void *valaddr, vector_iterator_t beg, vector_iterator_t end);
+
 void vector_qsort(vector_t *self,
                  int (*cmpfn)(const void *, const void *));
 
@@ -168,8 +364,15 @@ void vector_heapsort_b(vector_t *self, int (^cmp_b)(const void *, const void *))
 void vector_heapsort_range(vector_t *self, int (*cmpfn)(const void *, const void *), vector_iterator_t pos, vector_iterator_t end);
 void vector_heapsort_range_b(vector_t *self, int (^cmp_b)(const void *, const void *), vector_iterator_t pos, vector_iterator_t end);
 
+void vector_radix_sort_by_key(vector_t *self, uint64_t (*keyfn)(const void *));
+void vector_radix_sort_by_key_b(vector_t *self, uint64_t (^key_b)(const void *));
+
+void vector_radix_sort_by_key_range(vector_t *self, uint64_t (*keyfn)(const void *), vector_iterator_t pos, vector_iterator_t end);
+void vector_radix_sort_by_key_range_b(vector_t *self, uint64_t (^key_b)(const void *), vector_iterator_t pos, vector_iterator_t end);
+
 static vector_t *vector_new(size_t capacity);
 static vector_t *vector_new_alloc_fn(size_t capacity, void *(*allocfn)(size_t));
+static vector_t *vector_new_elem(size_t capacity, size_t elem_size);
 
 static void vector_delete(vector_t *self);
 static void vector_delete_free_fn(vector_t *self, void (*freefn)(void *));
@@ -244,8 +447,8 @@ static inline voidptr vector_front(vector_t *self) {
 */
 static inline voidptr vector_back(vector_t *self) {
     // m_finish is the address of one-past the last element;
-    // we subtract m_finish by 1 to get the element at the back of vector_t
-    return self->m_impl.m_finish - 1;
+    // we subtract m_finish by 1 block to get the element at the back of vector_t
+    return vector_advance(self, self->m_impl.m_finish, -1);
 }
 
 /*!
@@ -285,7 +488,7 @@ static inline voidptr vector_back(vector_t *self) {
     \endcode
 */
 static inline voidptr vector_at(vector_t *self, const int index) {
-    voidptr *result = self->m_impl.m_start + index;
+    voidptr *result = vector_advance(self, self->m_impl.m_start, index);
     return result >= self->m_impl.m_finish ? NULL : result;
 }
 
@@ -298,7 +501,7 @@ static inline voidptr vector_at(vector_t *self, const int index) {
     \return
  */
 static inline voidptr vector_i(vector_t *self, size_t index) {
-    return self->m_impl.m_start + index;
+    return vector_advance(self, self->m_impl.m_start, index);
 }
 
 /*!
@@ -320,7 +523,7 @@ static inline bool vector_empty(vector_t *self) {
     \return
 */
 static inline size_t vector_size(vector_t *self) {
-    return self->m_impl.m_finish - self->m_impl.m_start;
+    return vector_distance(self, self->m_impl.m_start, self->m_impl.m_finish);
 }
 
 /*!
@@ -331,7 +534,18 @@ static inline size_t vector_size(vector_t *self) {
     \return
 */
 static inline size_t vector_capacity(vector_t *self) {
-    return self->m_impl.m_end_of_storage - self->m_impl.m_start;
+    return vector_distance(self, self->m_impl.m_start, self->m_impl.m_end_of_storage);
+}
+
+/*!
+    \brief      Returns the width of one block, in bytes
+
+    \param[in]  self
+
+    \return     sizeof(voidptr), or the elem_size given to vector_init_elem
+*/
+static inline size_t vector_elem_size(vector_t *self) {
+    return self->m_impl.m_elem_size;
 }
 
 /*!
@@ -358,6 +572,36 @@ static inline vector_iterator_t vector_end(vector_t *self) {
     return self->m_impl.m_finish;
 }
 
+/*!
+    \brief      Moves an iterator n blocks forward (or backward, if n < 0)
+
+    For a vector made with vector_init, this is the same as it + n.
+    For a vector made with vector_init_elem, iterators address
+    elem_size-wide blocks, so plain pointer arithmetic will not work.
+
+    \param[in]  self
+    \param[in]  it
+    \param[in]  n
+
+    \return     it, advanced n blocks
+*/
+static inline vector_iterator_t vector_advance(vector_t *self, vector_iterator_t it, ptrdiff_t n) {
+    return (vector_iterator_t)((char *)(it) + n * (ptrdiff_t)self->m_impl.m_elem_size);
+}
+
+/*!
+    \brief      Returns the number of blocks in [beg, end)
+
+    \param[in]  self
+    \param[in]  beg
+    \param[in]  end
+
+    \return     end - beg, in blocks
+*/
+static inline ptrdiff_t vector_distance(vector_t *self, vector_iterator_t beg, vector_iterator_t end) {
+    return ((char *)(end) - (char *)(beg)) / (ptrdiff_t)self->m_impl.m_elem_size;
+}
+
 /*!
     \brief
 
@@ -370,15 +614,15 @@ static inline void vector_foreach_range(vector_t *self,
                                            void (*func)(void *),
                                            vector_iterator_t beg,
                                            vector_iterator_t end) {
-    while (beg < end) {
-        func(beg++);
+    for (; beg < end; beg = vector_advance(self, beg, 1)) {
+        func(beg);
     }
 }
 
 static inline void vector_foreach_range_b(vector_t *self, void (^block)(void *),
                                   vector_iterator_t beg, vector_iterator_t end) {
-    while (beg < end) {
-        block(beg++);
+    for (; beg < end; beg = vector_advance(self, beg, 1)) {
+        block(beg);
     }
 }
 
@@ -417,6 +661,24 @@ static inline vector_t *vector_new_alloc_fn(size_t capacity, void *(*allocfn)(si
     return v;
 }
 
+/*!
+    \brief
+ 
+    \param[in]  capacity
+    \param[in]  elem_size
+ 
+    \return
+ */
+static inline vector_t *vector_new_elem(size_t capacity, size_t elem_size) {
+    vector_t *v = NULL;
+    
+    if ((v = malloc(sizeof *v))) {
+        vector_init_elem(v, capacity, elem_size);
+    }
+    
+    return v;
+}
+
 /*!
     \brief
  
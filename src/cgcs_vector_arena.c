@@ -0,0 +1,217 @@
+/*!
+    \file       cgcs_vector_arena.c
+    \brief      Source file for a bump (arena) allocator for vector_t buffers
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_arena.h"
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+    \struct
+    \brief      Header of a block of memory the arena bumps through
+*/
+struct cgcs_vector_arena_chunk {
+    struct cgcs_vector_arena_chunk *m_next;
+    char *m_ptr;
+    char *m_end;
+    max_align_t m_data[];
+};
+
+static void *cgcs_vector_arena_allocfn(void *ctx, size_t size);
+static void *cgcs_vector_arena_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void cgcs_vector_arena_freefn(void *ctx, void *ptr, size_t size);
+
+/*!
+    \brief      Rounds size up, so that every allocation is suitably aligned
+
+    \param[in]  size
+
+    \return
+*/
+static inline size_t
+cgcs_vector_arena_align(size_t size) {
+    const size_t align = alignof(max_align_t);
+    return (size + align - 1) & ~(align - 1);
+}
+
+/*!
+    \brief      Rounds size up to a nonzero, aligned block size
+
+    An empty block still takes one aligned unit, so that it never shares
+    its address with the next allocation (which would let the in-place
+    growth path in cgcs_vector_arena_reallocfn overwrite it).
+
+    \param[in]  size
+
+    \return
+*/
+static inline size_t
+cgcs_vector_arena_block_size(size_t size) {
+    return cgcs_vector_arena_align(size ? size : 1);
+}
+
+/*!
+    \brief      Makes a new chunk, of at least size bytes, the head of the arena
+
+    \param[in]  self
+    \param[in]  size
+
+    \return
+*/
+static struct cgcs_vector_arena_chunk *
+cgcs_vector_arena_new_chunk(vector_arena_t *self, size_t size) {
+    const size_t capacity = size > self->m_chunk_size ? size : self->m_chunk_size;
+    struct cgcs_vector_arena_chunk *chunk = malloc(sizeof *chunk + capacity);
+    assert(chunk);
+
+    chunk->m_ptr = (char *)chunk->m_data;
+    chunk->m_end = chunk->m_ptr + capacity;
+
+    chunk->m_next = self->m_head;
+    self->m_head = chunk;
+
+    return chunk;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  chunk_size
+*/
+void vector_arena_init(vector_arena_t *self, size_t chunk_size) {
+    self->m_head = NULL;
+    self->m_last = NULL;
+    self->m_chunk_size = cgcs_vector_arena_align(chunk_size);
+
+    self->m_alloc.m_allocfn = cgcs_vector_arena_allocfn;
+    self->m_alloc.m_reallocfn = cgcs_vector_arena_reallocfn;
+    self->m_alloc.m_freefn = cgcs_vector_arena_freefn;
+    self->m_alloc.m_ctx = self;
+}
+
+/*!
+    \brief      Returns every chunk to the system
+
+    \param[in]  self
+*/
+void vector_arena_deinit(vector_arena_t *self) {
+    struct cgcs_vector_arena_chunk *chunk = self->m_head;
+
+    while (chunk) {
+        struct cgcs_vector_arena_chunk *next = chunk->m_next;
+        free(chunk);
+        chunk = next;
+    }
+
+    self->m_head = NULL;
+    self->m_last = NULL;
+}
+
+/*!
+    \brief      Releases every allocation made from the arena at once
+
+    The newest chunk is kept (and rewound) for the next batch of vectors,
+    so a steady-state workload stops calling malloc altogether.
+
+    \param[in]  self
+*/
+void vector_arena_reset(vector_arena_t *self) {
+    struct cgcs_vector_arena_chunk *head = self->m_head;
+
+    if (head) {
+        struct cgcs_vector_arena_chunk *chunk = head->m_next;
+
+        while (chunk) {
+            struct cgcs_vector_arena_chunk *next = chunk->m_next;
+            free(chunk);
+            chunk = next;
+        }
+
+        head->m_next = NULL;
+        head->m_ptr = (char *)head->m_data;
+    }
+
+    self->m_last = NULL;
+}
+
+/*!
+    \brief
+
+    \param[in]  ctx
+    \param[in]  size
+
+    \return
+*/
+static void *cgcs_vector_arena_allocfn(void *ctx, size_t size) {
+    vector_arena_t *self = ctx;
+    struct cgcs_vector_arena_chunk *chunk = self->m_head;
+    char *ptr = NULL;
+
+    size = cgcs_vector_arena_block_size(size);
+
+    if (chunk == NULL || (size_t)(chunk->m_end - chunk->m_ptr) < size) {
+        chunk = cgcs_vector_arena_new_chunk(self, size);
+    }
+
+    ptr = chunk->m_ptr;
+    chunk->m_ptr += size;
+
+    self->m_last = ptr;
+    return ptr;
+}
+
+/*!
+    \brief      Grows (or shrinks) ptr in place if it is the most recent
+                allocation and its chunk has room, otherwise moves it
+
+    \param[in]  ctx
+    \param[in]  ptr
+    \param[in]  old_size
+    \param[in]  new_size
+
+    \return
+*/
+static void *cgcs_vector_arena_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    vector_arena_t *self = ctx;
+    char *result = NULL;
+
+    if (ptr && ptr == self->m_last &&
+        (size_t)(self->m_head->m_end - self->m_last) >= cgcs_vector_arena_block_size(new_size)) {
+        self->m_head->m_ptr = self->m_last + cgcs_vector_arena_block_size(new_size);
+        return ptr;
+    }
+
+    result = cgcs_vector_arena_allocfn(ctx, new_size);
+
+    if (ptr) {
+        memcpy(result, ptr, old_size < new_size ? old_size : new_size);
+    }
+
+    // The old block is not reclaimed until vector_arena_reset.
+    return result;
+}
+
+/*!
+    \brief      Reclaims ptr only if it is the most recent allocation;
+                everything else waits for vector_arena_reset
+
+    \param[in]  ctx
+    \param[in]  ptr
+    \param[in]  size
+*/
+static void cgcs_vector_arena_freefn(void *ctx, void *ptr, size_t size) {
+    vector_arena_t *self = ctx;
+
+    if (ptr && ptr == self->m_last) {
+        self->m_head->m_ptr = self->m_last;
+        self->m_last = NULL;
+    }
+}
@@ -0,0 +1,80 @@
+/*!
+    \file       cgcs_vector_arena.h
+    \brief      Header file for a bump (arena) allocator for vector_t buffers
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_ARENA_H
+#define CGCS_VECTOR_ARENA_H
+
+#include "cgcs_vector.h"
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_arena vector_arena_t;
+
+/*!
+    \struct
+    \brief      A bump allocator that any number of vectors can share
+
+    Vectors initialized with vector_init_allocator(&v, capacity,
+    vector_arena_allocator(&arena)) carve their buffers out of the arena's
+    chunks. When the most recent allocation grows (the common case, when
+    a vector is filled before the next one is created), it is extended in
+    place without copying.
+
+    vector_arena_reset releases every vector's storage at once;
+    there is no need to call vector_deinit on each vector beforehand,
+    but none of those vectors may be used afterwards (without being
+    initialized again).
+
+    The arena addresses itself through m_alloc.m_ctx,
+    so it must not be moved or copied once initialized.
+
+    \code
+        vector_arena_t arena;
+        vector_arena_init(&arena, 64 * 1024);
+
+        for (;;) {
+            vector_t a, b;
+            vector_init_allocator(&a, 16, vector_arena_allocator(&arena));
+            vector_init_allocator(&b, 16, vector_arena_allocator(&arena));
+
+            // ... handle a request ...
+
+            vector_arena_reset(&arena); // a and b are gone
+        }
+
+        vector_arena_deinit(&arena);
+    \endcode
+*/
+struct cgcs_vector_arena {
+    struct cgcs_vector_arena_chunk *m_head;     // chunk currently bumped; newest first
+    char *m_last;                               // most recent allocation in m_head, or NULL
+    size_t m_chunk_size;                        // minimum bytes per chunk
+    vector_allocator_t m_alloc;
+};
+
+void vector_arena_init(vector_arena_t *self, size_t chunk_size);
+void vector_arena_deinit(vector_arena_t *self);
+
+void vector_arena_reset(vector_arena_t *self);
+
+static const vector_allocator_t *vector_arena_allocator(vector_arena_t *self);
+
+/*!
+    \brief      Returns the allocator to give to vector_init_allocator
+
+    \param[in]  self
+
+    \return
+*/
+static inline const vector_allocator_t *vector_arena_allocator(vector_arena_t *self) {
+    return &(self->m_alloc);
+}
+
+#endif /* CGCS_VECTOR_ARENA_H */
@@ -0,0 +1,220 @@
+/*!
+    \file       cgcs_vector_cache.c
+    \brief      Source file for an allocator that recycles vector_t buffers
+                through per-thread caches
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_cache.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <string.h>
+
+// Buffers of 2^6 (64 B) to 2^20 (1 MiB) bytes are cached.
+#define CGCS_VECTOR_CACHE_MIN_SHIFT 6
+#define CGCS_VECTOR_CACHE_MAX_SHIFT 20
+#define CGCS_VECTOR_CACHE_CLASSES (CGCS_VECTOR_CACHE_MAX_SHIFT - CGCS_VECTOR_CACHE_MIN_SHIFT + 1)
+
+// Buffers kept per class, per thread.
+#define CGCS_VECTOR_CACHE_DEPTH 8
+
+/*!
+    \struct
+    \brief      A thread's cached buffers
+
+    Each class is a stack of free buffers, linked through
+    their first bytes.
+*/
+struct cgcs_vector_cache {
+    void *m_heads[CGCS_VECTOR_CACHE_CLASSES];
+    unsigned m_counts[CGCS_VECTOR_CACHE_CLASSES];
+    bool m_registered;          // with cgcs_vector_cache_key, for thread exit
+};
+
+static _Thread_local struct cgcs_vector_cache cgcs_vector_cache_self;
+
+static pthread_key_t cgcs_vector_cache_key;
+static pthread_once_t cgcs_vector_cache_once = PTHREAD_ONCE_INIT;
+
+static void *cgcs_vector_cache_allocfn(void *ctx, size_t size);
+static void *cgcs_vector_cache_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void cgcs_vector_cache_freefn(void *ctx, void *ptr, size_t size);
+
+const vector_allocator_t cgcs_vector_cache_allocator = {
+    .m_allocfn = cgcs_vector_cache_allocfn,
+    .m_reallocfn = cgcs_vector_cache_reallocfn,
+    .m_freefn = cgcs_vector_cache_freefn,
+    .m_ctx = NULL
+};
+
+/*!
+    \brief      Returns the class of a buffer of size bytes:
+                log2(size rounded up to a power of 2) - CGCS_VECTOR_CACHE_MIN_SHIFT
+
+    \param[in]  size
+
+    \return     a class past the last one if size is not cached
+*/
+static inline size_t cgcs_vector_cache_class(size_t size) {
+    if (size <= ((size_t)1 << CGCS_VECTOR_CACHE_MIN_SHIFT)) {
+        return 0;
+    }
+
+    return (size_t)(sizeof(unsigned long long) * 8 - __builtin_clzll(size - 1)) -
+           CGCS_VECTOR_CACHE_MIN_SHIFT;
+}
+
+/*!
+    \brief      Frees every buffer in cache
+
+    \param[in]  cache
+*/
+static void cgcs_vector_cache_drain(struct cgcs_vector_cache *cache) {
+    for (size_t k = 0; k < CGCS_VECTOR_CACHE_CLASSES; k++) {
+        while (cache->m_heads[k]) {
+            void *next = NULL;
+
+            memcpy(&next, cache->m_heads[k], sizeof next);
+            free(cache->m_heads[k]);
+            cache->m_heads[k] = next;
+        }
+
+        cache->m_counts[k] = 0;
+    }
+}
+
+/*!
+    \brief      Destructor of cgcs_vector_cache_key: runs at thread exit
+                with the exiting thread's cache
+
+    \param[in]  cache
+*/
+static void cgcs_vector_cache_destructor(void *cache) {
+    cgcs_vector_cache_drain(cache);
+
+    // Another destructor may still free a vector into the cache;
+    // it registers again, and pthreads runs this again.
+    ((struct cgcs_vector_cache *)cache)->m_registered = false;
+}
+
+static void cgcs_vector_cache_create_key(void) {
+    const int rc = pthread_key_create(&cgcs_vector_cache_key, cgcs_vector_cache_destructor);
+    assert(rc == 0);
+    (void)rc;
+}
+
+static void *cgcs_vector_cache_allocfn(void *ctx, size_t size) {
+    struct cgcs_vector_cache *cache = &cgcs_vector_cache_self;
+    const size_t k = cgcs_vector_cache_class(size);
+    void *ptr = NULL;
+
+    if (k >= CGCS_VECTOR_CACHE_CLASSES) {
+        return malloc(size);
+    }
+
+    if (cache->m_heads[k]) {
+        ptr = cache->m_heads[k];
+        memcpy(&cache->m_heads[k], ptr, sizeof ptr);
+        --cache->m_counts[k];
+
+        return ptr;
+    }
+
+    return malloc((size_t)1 << (k + CGCS_VECTOR_CACHE_MIN_SHIFT));
+}
+
+/*!
+    \brief      Resizes a buffer of the allocator
+
+    Within a class, nothing moves: every buffer already has the size
+    of its class. Between uncached sizes, this is realloc.
+
+    \param[in]  ctx
+    \param[in]  ptr
+    \param[in]  old_size
+    \param[in]  new_size
+
+    \return
+*/
+static void *cgcs_vector_cache_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    const size_t old_k = cgcs_vector_cache_class(old_size);
+    const size_t new_k = cgcs_vector_cache_class(new_size);
+    void *moved = NULL;
+
+    if (old_k == new_k && old_k < CGCS_VECTOR_CACHE_CLASSES) {
+        return ptr;
+    }
+
+    if (old_k >= CGCS_VECTOR_CACHE_CLASSES && new_k >= CGCS_VECTOR_CACHE_CLASSES) {
+        return realloc(ptr, new_size);
+    }
+
+    moved = cgcs_vector_cache_allocfn(ctx, new_size);
+
+    if (moved == NULL) {
+        return NULL;
+    }
+
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    cgcs_vector_cache_freefn(ctx, ptr, old_size);
+
+    return moved;
+}
+
+static void cgcs_vector_cache_freefn(void *ctx, void *ptr, size_t size) {
+    struct cgcs_vector_cache *cache = &cgcs_vector_cache_self;
+    const size_t k = cgcs_vector_cache_class(size);
+
+    if (k >= CGCS_VECTOR_CACHE_CLASSES || cache->m_counts[k] == CGCS_VECTOR_CACHE_DEPTH) {
+        free(ptr);
+        return;
+    }
+
+    if (cache->m_registered == false) {
+        // The first buffer this thread keeps: free them all when it exits.
+        pthread_once(&cgcs_vector_cache_once, cgcs_vector_cache_create_key);
+        pthread_setspecific(cgcs_vector_cache_key, cache);
+        cache->m_registered = true;
+    }
+
+    memcpy(ptr, &cache->m_heads[k], sizeof ptr);
+    cache->m_heads[k] = ptr;
+    ++cache->m_counts[k];
+}
+
+/*!
+    \brief      Initializes a vector of pointers whose buffer comes from
+                (and returns to) the calling thread's cache
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_init_cached(vector_t *self, size_t capacity) {
+    vector_init_elem_cached(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief      Initializes a vector of elem_size-byte blocks whose buffer
+                comes from (and returns to) the calling thread's cache
+
+    The buffer is not zeroed, at init or by vector_clear
+    (CGCS_VECTOR_FILL_NONE).
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_init_elem_cached(vector_t *self, size_t capacity, size_t elem_size) {
+    vector_init_elem_allocator_fill(self, capacity, elem_size, &cgcs_vector_cache_allocator,
+                                    CGCS_VECTOR_FILL_NONE);
+}
+
+/*!
+    \brief      Frees every buffer in the calling thread's cache
+*/
+void vector_cache_trim(void) {
+    cgcs_vector_cache_drain(&cgcs_vector_cache_self);
+}
@@ -0,0 +1,45 @@
+/*!
+    \file       cgcs_vector_cache.h
+    \brief      Header file for an allocator that recycles vector_t buffers
+                through per-thread caches
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_CACHE_H
+#define CGCS_VECTOR_CACHE_H
+
+#include "cgcs_vector.h"
+
+/*
+    Code that makes and discards many short-lived vectors spends most
+    of its time in malloc, free and memset. cgcs_vector_cache_allocator
+    rounds every buffer up to a power of 2 between 64 bytes and 1 MiB,
+    and keeps the buffers it is given back in the calling thread's
+    cache, a few per size: the next vector of that size takes one
+    without locking or calling malloc. Larger buffers go straight to
+    malloc and free.
+
+    vector_init_cached and vector_init_elem_cached initialize vectors
+    with that allocator and CGCS_VECTOR_FILL_NONE, so that neither init
+    nor vector_clear touches the buffer -- a recycled buffer holds
+    whatever its last vector left there. vector_deinit returns it.
+
+    A buffer may be freed by another thread than the one that allocated
+    it; it joins the freeing thread's cache. A thread's cache is freed
+    when the thread exits, or by vector_cache_trim.
+*/
+
+/*!
+    \brief      The allocator behind vector_init_cached; may also be given
+                to vector_init_allocator and the like
+*/
+extern const vector_allocator_t cgcs_vector_cache_allocator;
+
+void vector_init_cached(vector_t *self, size_t capacity);
+void vector_init_elem_cached(vector_t *self, size_t capacity, size_t elem_size);
+
+void vector_cache_trim(void);
+
+#endif /* CGCS_VECTOR_CACHE_H */
@@ -0,0 +1,307 @@
+/*!
+    \file       cgcs_vector_concurrent.c
+    \brief      Source file for a vector many threads can append to at once,
+                sealed into an ordinary vector_t afterwards
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_concurrent.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*!
+    \brief      Returns the number of blocks segment k holds
+
+    \param[in]  self
+    \param[in]  k
+
+    \return
+*/
+static inline size_t
+cgcs_vector_concurrent_seg_capacity(vector_concurrent_t *self, size_t k) {
+    return (size_t)1 << (self->m_shift + k);
+}
+
+/*!
+    \brief      Returns the position of the first block of segment k
+
+    \param[in]  self
+    \param[in]  k
+
+    \return
+*/
+static inline size_t
+cgcs_vector_concurrent_seg_first(vector_concurrent_t *self, size_t k) {
+    return (((size_t)1 << k) - 1) << self->m_shift;
+}
+
+/*!
+    \brief      Returns the segment holding the block at position pos
+
+    \param[in]  self
+    \param[in]  pos
+
+    \return
+*/
+static inline size_t
+cgcs_vector_concurrent_seg_of(vector_concurrent_t *self, size_t pos) {
+    // Segment k covers [(2^k - 1) << m_shift, (2^(k+1) - 1) << m_shift).
+    const unsigned long long q = (pos >> self->m_shift) + 1;
+    return (size_t)(sizeof q * 8 - 1 - __builtin_clzll(q));
+}
+
+/*!
+    \brief      Returns segment k, allocating it if no thread has yet
+
+    \param[in]  self
+    \param[in]  k
+
+    \return
+*/
+static voidptr *
+cgcs_vector_concurrent_seg(vector_concurrent_t *self, size_t k) {
+    const vector_allocator_t *alloc = self->m_alloc;
+    const size_t size = self->m_elem_size * cgcs_vector_concurrent_seg_capacity(self, k);
+    voidptr *seg = NULL;
+    voidptr *installed = NULL;
+
+    assert(k < CGCS_VECTOR_CONCURRENT_SEGMENTS);
+
+    seg = __atomic_load_n(&self->m_segs[k], __ATOMIC_ACQUIRE);
+
+    if (seg) {
+        return seg;
+    }
+
+    seg = alloc->m_allocfn(alloc->m_ctx, size);
+    assert(seg);
+
+    if (__atomic_compare_exchange_n(&self->m_segs[k], &installed, seg, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return seg;
+    }
+
+    // Another thread installed the segment first.
+    alloc->m_freefn(alloc->m_ctx, seg, size);
+    return installed;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_concurrent_init(vector_concurrent_t *self, size_t capacity) {
+    vector_concurrent_init_elem(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_concurrent_init_elem(vector_concurrent_t *self, size_t capacity, size_t elem_size) {
+    vector_concurrent_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  alloc
+*/
+void vector_concurrent_init_allocator(vector_concurrent_t *self, size_t capacity,
+                                      const vector_allocator_t *alloc) {
+    vector_concurrent_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief      Initializes an empty vector_concurrent_t whose first segment
+                holds capacity blocks of elem_size bytes
+
+    capacity is rounded up to a power of 2. The first segment is
+    allocated here; later segments are allocated as appends reach them.
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+void vector_concurrent_init_elem_allocator(vector_concurrent_t *self, size_t capacity,
+                                           size_t elem_size, const vector_allocator_t *alloc) {
+    assert(elem_size > 0);
+    assert(alloc);
+
+    self->m_size = 0;
+    self->m_shift = 0;
+    self->m_elem_size = elem_size;
+    self->m_alloc = alloc;
+
+    while (((size_t)1 << self->m_shift) < capacity) {
+        ++self->m_shift;
+    }
+
+    for (size_t k = 0; k < CGCS_VECTOR_CONCURRENT_SEGMENTS; k++) {
+        self->m_segs[k] = NULL;
+    }
+
+    cgcs_vector_concurrent_seg(self, 0);
+}
+
+/*!
+    \brief      Frees every segment of self
+
+    No thread may be appending to self.
+
+    \param[in]  self
+*/
+void vector_concurrent_deinit(vector_concurrent_t *self) {
+    const vector_allocator_t *alloc = self->m_alloc;
+
+    for (size_t k = 0; k < CGCS_VECTOR_CONCURRENT_SEGMENTS; k++) {
+        if (self->m_segs[k]) {
+            alloc->m_freefn(alloc->m_ctx, self->m_segs[k],
+                            self->m_elem_size * cgcs_vector_concurrent_seg_capacity(self, k));
+            self->m_segs[k] = NULL;
+        }
+    }
+
+    self->m_size = 0;
+}
+
+/*!
+    \brief      Appends a copy of the block at valaddr; safe to call
+                from any number of threads at once
+
+    \param[in]  self
+    \param[in]  valaddr
+
+    \return     position of the block (its index once sealed)
+*/
+size_t vector_concurrent_push_back(vector_concurrent_t *self, const void *valaddr) {
+    return vector_concurrent_append_n(self, valaddr, 1);
+}
+
+/*!
+    \brief      Appends copies of the n blocks at src, contiguously;
+                safe to call from any number of threads at once
+
+    Claiming n slots costs one atomic operation, whatever n is,
+    so producers that batch their blocks contend less.
+
+    \param[in]  self
+    \param[in]  src
+    \param[in]  n
+
+    \return     position of the first block (its index once sealed)
+*/
+size_t vector_concurrent_append_n(vector_concurrent_t *self, const void *src, size_t n) {
+    const size_t first = __atomic_fetch_add(&self->m_size, n, __ATOMIC_RELAXED);
+    const char *from = src;
+    size_t pos = first;
+
+    // The claimed slots may straddle segments.
+    while (n > 0) {
+        const size_t k = cgcs_vector_concurrent_seg_of(self, pos);
+        const size_t offset = pos - cgcs_vector_concurrent_seg_first(self, k);
+        const size_t room = cgcs_vector_concurrent_seg_capacity(self, k) - offset;
+        const size_t count = n < room ? n : room;
+        char *seg = (char *)cgcs_vector_concurrent_seg(self, k);
+
+        memcpy(seg + offset * self->m_elem_size, from, count * self->m_elem_size);
+
+        from += count * self->m_elem_size;
+        pos += count;
+        n -= count;
+    }
+
+    return first;
+}
+
+/*!
+    \brief      Returns the number of slots claimed so far
+
+    While producers run, blocks may still be on their way into
+    the most recently claimed slots.
+
+    \param[in]  self
+
+    \return
+*/
+size_t vector_concurrent_size(vector_concurrent_t *self) {
+    return __atomic_load_n(&self->m_size, __ATOMIC_RELAXED);
+}
+
+/*!
+    \brief      Moves every block of self into dst, an ordinary vector_t,
+                leaving self empty
+
+    Every append to self must have returned, and be visible to the
+    calling thread (i.e. the producers were joined), before the call.
+    dst is initialized here -- it must not already be -- with self's
+    allocator and element size, and is released with vector_deinit.
+
+    If the blocks fit in the first segment, dst takes it over as is;
+    otherwise the first segment is resized (in place, if the allocator
+    can) and the other segments are copied after it, then freed.
+    self can be appended to again, or deinitialized.
+
+    \param[in]  self
+    \param[in]  dst
+*/
+void vector_seal(vector_concurrent_t *self, vector_t *dst) {
+    const vector_allocator_t *alloc = self->m_alloc;
+    const size_t elem_size = self->m_elem_size;
+    const size_t size = self->m_size;
+    size_t capacity = cgcs_vector_concurrent_seg_capacity(self, 0);
+    char *start = (char *)cgcs_vector_concurrent_seg(self, 0);
+
+    if (size > capacity) {
+        if (alloc->m_reallocfn) {
+            start = alloc->m_reallocfn(alloc->m_ctx, start, elem_size * capacity, elem_size * size);
+            assert(start);
+        } else {
+            char *old = start;
+
+            start = alloc->m_allocfn(alloc->m_ctx, elem_size * size);
+            assert(start);
+            memcpy(start, old, elem_size * capacity);
+            alloc->m_freefn(alloc->m_ctx, old, elem_size * capacity);
+        }
+
+        capacity = size;
+    }
+
+    self->m_segs[0] = NULL;
+
+    for (size_t k = 1; k < CGCS_VECTOR_CONCURRENT_SEGMENTS && self->m_segs[k]; k++) {
+        const size_t seg_first = cgcs_vector_concurrent_seg_first(self, k);
+        const size_t seg_capacity = cgcs_vector_concurrent_seg_capacity(self, k);
+        const size_t used = size - seg_first < seg_capacity ? size - seg_first : seg_capacity;
+
+        memcpy(start + elem_size * seg_first, self->m_segs[k], elem_size * used);
+
+        alloc->m_freefn(alloc->m_ctx, self->m_segs[k], elem_size * seg_capacity);
+        self->m_segs[k] = NULL;
+    }
+
+    self->m_size = 0;
+
+    dst->m_impl.m_start = (voidptr *)start;
+    dst->m_impl.m_finish = (voidptr *)(start + elem_size * size);
+    dst->m_impl.m_end_of_storage = (voidptr *)(start + elem_size * capacity);
+    dst->m_impl.m_elem_size = elem_size;
+    dst->m_impl.m_inline = NULL;
+    dst->m_impl.m_alloc = alloc;
+
+    vector_set_growth(dst, CGCS_VECTOR_GROWTH_FACTOR_2, 0);
+    vector_set_fill(dst, CGCS_VECTOR_FILL_ZERO);
+    dst->m_index = NULL;
+}
@@ -0,0 +1,83 @@
+/*!
+    \file       cgcs_vector_concurrent.h
+    \brief      Header file for a vector many threads can append to at once,
+                sealed into an ordinary vector_t afterwards
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_CONCURRENT_H
+#define CGCS_VECTOR_CONCURRENT_H
+
+#include "cgcs_vector.h"
+
+// Segments a vector_concurrent_t can have; segment k holds capacity << k blocks.
+#define CGCS_VECTOR_CONCURRENT_SEGMENTS 48
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_concurrent vector_concurrent_t;
+
+/*!
+    \struct
+    \brief      Append-only storage that any number of threads
+                may push to without a lock
+
+    Each append claims its slots with one atomic fetch-add on m_size,
+    then copies its blocks in. Storage is a list of segments, each twice
+    the size of the one before it. Segments never move or get freed while
+    blocks are appended, so no writer can write into a freed block.
+    The first thread to reach a missing segment allocates it and installs
+    it with a compare-and-swap; a thread that loses the race frees its copy.
+    The allocator must therefore be safe to call from several threads
+    (cgcs_vector_malloc_allocator is; a vector_arena_t is not).
+
+    Once every producer is done (i.e. joined), vector_seal moves
+    the blocks into a vector_t for the rest of the API. If they all fit
+    in the first segment, no blocks are copied at all, so a good
+    capacity estimate makes sealing free.
+
+    \code
+        vector_concurrent_t results;
+        vector_concurrent_init(&results, 4096);
+
+        // on any number of threads:
+        vector_concurrent_push_back(&results, &ptr);
+
+        // once they are joined:
+        vector_t v;
+        vector_seal(&results, &v);
+        vector_concurrent_deinit(&results);
+    \endcode
+*/
+struct cgcs_vector_concurrent {
+    // Claimed slots. Written by every producer, so it has a cache line
+    // to itself, apart from the read-mostly fields below.
+    _Alignas(64) size_t m_size;
+
+    _Alignas(64) voidptr *m_segs[CGCS_VECTOR_CONCURRENT_SEGMENTS];
+    size_t m_shift;                 // log2 of the capacity of segment 0
+    size_t m_elem_size;
+    const vector_allocator_t *m_alloc;
+};
+
+void vector_concurrent_init(vector_concurrent_t *self, size_t capacity);
+void vector_concurrent_init_elem(vector_concurrent_t *self, size_t capacity, size_t elem_size);
+void vector_concurrent_init_allocator(vector_concurrent_t *self, size_t capacity,
+                                      const vector_allocator_t *alloc);
+void vector_concurrent_init_elem_allocator(vector_concurrent_t *self, size_t capacity,
+                                           size_t elem_size, const vector_allocator_t *alloc);
+
+void vector_concurrent_deinit(vector_concurrent_t *self);
+
+size_t vector_concurrent_push_back(vector_concurrent_t *self, const void *valaddr);
+size_t vector_concurrent_append_n(vector_concurrent_t *self, const void *src, size_t n);
+
+size_t vector_concurrent_size(vector_concurrent_t *self);
+
+void vector_seal(vector_concurrent_t *self, vector_t *dst);
+
+#endif /* CGCS_VECTOR_CONCURRENT_H */
@@ -0,0 +1,352 @@
+/*!
+    \file       cgcs_vector_gap.c
+    \brief      Source file for a gap buffer on vector_t storage,
+                for insertion and erasure around a moving cursor
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_gap.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*!
+    \brief      Copies one block from valaddr into dst
+
+    \param[in]  base
+    \param[in]  dst
+    \param[in]  valaddr
+*/
+static inline void
+cgcs_vector_gap_assign(struct cgcs_vector_base *base, void *dst, const void *valaddr) {
+    if (base->m_elem_size == sizeof(voidptr)) {
+        *(voidptr *)(dst) = *(void **)(valaddr);
+    } else {
+        memcpy(dst, valaddr, base->m_elem_size);
+    }
+}
+
+/*!
+    \brief      Grows self so that its gap holds at least n blocks
+
+    The capacity at least doubles. The buffer is resized (in place,
+    if the allocator can), then the blocks after the gap move to the
+    back of the new buffer; the gap stays where it was.
+
+    \param[in]  self
+    \param[in]  n
+*/
+static void cgcs_vector_gap_grow(vector_gap_t *self, size_t n) {
+    struct cgcs_vector_base *base = &(self->m_impl);
+    const vector_allocator_t *alloc = base->m_alloc;
+    const size_t elem_size = base->m_elem_size;
+    const size_t capacity = vector_gap_capacity(self);
+    const size_t tail = capacity - self->m_gap_end;
+    const size_t required = vector_gap_size(self) + n;
+    size_t new_capacity = capacity * 2;
+    char *start = NULL;
+
+    new_capacity = new_capacity > required ? new_capacity : required;
+
+    if (alloc->m_reallocfn) {
+        start = alloc->m_reallocfn(alloc->m_ctx, base->m_start,
+                                   elem_size * capacity, elem_size * new_capacity);
+        assert(start);
+    } else {
+        start = alloc->m_allocfn(alloc->m_ctx, elem_size * new_capacity);
+        assert(start);
+        memcpy(start, base->m_start, elem_size * capacity);
+        alloc->m_freefn(alloc->m_ctx, base->m_start, elem_size * capacity);
+    }
+
+    memmove(start + elem_size * (new_capacity - tail), start + elem_size * self->m_gap_end,
+            elem_size * tail);
+
+    base->m_start = (voidptr *)start;
+    base->m_finish = base->m_start;
+    base->m_end_of_storage = (voidptr *)(start + elem_size * new_capacity);
+
+    self->m_gap_end = new_capacity - tail;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_gap_init(vector_gap_t *self, size_t capacity) {
+    vector_gap_init_elem(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_gap_init_elem(vector_gap_t *self, size_t capacity, size_t elem_size) {
+    vector_gap_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  alloc
+*/
+void vector_gap_init_allocator(vector_gap_t *self, size_t capacity,
+                               const vector_allocator_t *alloc) {
+    vector_gap_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief      Initializes an empty gap buffer of elem_size-byte blocks
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+void vector_gap_init_elem_allocator(vector_gap_t *self, size_t capacity, size_t elem_size,
+                                    const vector_allocator_t *alloc) {
+    struct cgcs_vector_base *base = &(self->m_impl);
+
+    assert(elem_size > 0);
+    assert(alloc);
+
+    capacity = capacity > 0 ? capacity : 1;
+
+    base->m_elem_size = elem_size;
+    base->m_alloc = alloc;
+    base->m_inline = NULL;
+
+    base->m_start = alloc->m_allocfn(alloc->m_ctx, elem_size * capacity);
+    assert(base->m_start);
+
+    base->m_finish = base->m_start;
+    base->m_end_of_storage = (voidptr *)((char *)base->m_start + elem_size * capacity);
+
+    self->m_gap_begin = 0;
+    self->m_gap_end = capacity;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_gap_deinit(vector_gap_t *self) {
+    struct cgcs_vector_base *base = &(self->m_impl);
+    const vector_allocator_t *alloc = base->m_alloc;
+
+    alloc->m_freefn(alloc->m_ctx, base->m_start,
+                    (char *)base->m_end_of_storage - (char *)base->m_start);
+
+    base->m_start = NULL;
+    base->m_finish = NULL;
+    base->m_end_of_storage = NULL;
+
+    self->m_gap_begin = 0;
+    self->m_gap_end = 0;
+}
+
+/*!
+    \brief      Moves the gap to position pos (0 <= pos <= size),
+                copying the blocks between the old position and the new
+
+    Insertions and erasures call this themselves; calling it ahead of
+    time only moves the cost (e.g. to when the cursor moves).
+
+    \param[in]  self
+    \param[in]  pos
+*/
+void vector_gap_move(vector_gap_t *self, size_t pos) {
+    const size_t elem_size = self->m_impl.m_elem_size;
+    const size_t gap = self->m_gap_end - self->m_gap_begin;
+
+    assert(pos <= vector_gap_size(self));
+
+    if (pos < self->m_gap_begin) {
+        // Blocks [pos, m_gap_begin) move to the other side of the gap.
+        const size_t n = self->m_gap_begin - pos;
+
+        memmove(cgcs_vector_gap_slot(self, pos + gap), cgcs_vector_gap_slot(self, pos),
+                elem_size * n);
+    } else if (pos > self->m_gap_begin) {
+        // Blocks [m_gap_begin, pos) move from after the gap to before it.
+        const size_t n = pos - self->m_gap_begin;
+
+        memmove(cgcs_vector_gap_slot(self, self->m_gap_begin),
+                cgcs_vector_gap_slot(self, self->m_gap_end), elem_size * n);
+    }
+
+    self->m_gap_begin = pos;
+    self->m_gap_end = pos + gap;
+}
+
+/*!
+    \brief      Inserts one block at position pos, leaving the gap after it
+
+    Consecutive calls at pos, pos + 1, pos + 2, ... (typing)
+    move no blocks at all, except when the buffer grows.
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  valaddr
+
+    \return     the address of the new block
+*/
+voidptr vector_gap_insert(vector_gap_t *self, size_t pos, const void *valaddr) {
+    voidptr dst = NULL;
+
+    vector_gap_move(self, pos);
+
+    if (self->m_gap_begin == self->m_gap_end) {
+        cgcs_vector_gap_grow(self, 1);
+    }
+
+    dst = cgcs_vector_gap_slot(self, self->m_gap_begin++);
+    cgcs_vector_gap_assign(&(self->m_impl), dst, valaddr);
+
+    return dst;
+}
+
+/*!
+    \brief      Inserts the n blocks addressed by src at position pos,
+                growing (at most) once
+
+    For a gap buffer made with vector_gap_init, src is an array of n pointers.
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  src
+    \param[in]  n
+
+    \return     the address of the first new block
+*/
+voidptr vector_gap_insert_n(vector_gap_t *self, size_t pos, const void *src, size_t n) {
+    voidptr dst = NULL;
+
+    vector_gap_move(self, pos);
+
+    if (self->m_gap_end - self->m_gap_begin < n) {
+        cgcs_vector_gap_grow(self, n);
+    }
+
+    dst = cgcs_vector_gap_slot(self, self->m_gap_begin);
+    memcpy(dst, src, self->m_impl.m_elem_size * n);
+    self->m_gap_begin += n;
+
+    return dst;
+}
+
+/*!
+    \brief      Erases the block at position pos
+
+    \param[in]  self
+    \param[in]  pos
+*/
+void vector_gap_erase(vector_gap_t *self, size_t pos) {
+    vector_gap_erase_n(self, pos, 1);
+}
+
+/*!
+    \brief      Erases the n blocks at [pos, pos + n)
+
+    The gap moves to whichever end of the range is closer to it, then
+    widens over the range -- so erasing forwards (pos, pos, ...) and
+    backwards (pos, pos - 1, ...) from the cursor both move no blocks.
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  n
+*/
+void vector_gap_erase_n(vector_gap_t *self, size_t pos, size_t n) {
+    assert(pos + n <= vector_gap_size(self));
+
+    if (pos + n <= self->m_gap_begin ||
+        (pos < self->m_gap_begin && self->m_gap_begin - pos > pos + n - self->m_gap_begin)) {
+        vector_gap_move(self, pos + n);
+        self->m_gap_begin -= n;
+    } else {
+        vector_gap_move(self, pos);
+        self->m_gap_end += n;
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  valaddr
+*/
+void vector_gap_push_back(vector_gap_t *self, const void *valaddr) {
+    vector_gap_insert(self, vector_gap_size(self), valaddr);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_gap_clear(vector_gap_t *self) {
+    self->m_gap_begin = 0;
+    self->m_gap_end = vector_gap_capacity(self);
+}
+
+/*!
+    \brief      Moves the gap to the back, so that the blocks are contiguous,
+                and returns the address of the first one
+
+    The blocks stay contiguous, at [address, address + size),
+    until a block is inserted or erased anywhere but at the back.
+
+    \param[in]  self
+
+    \return
+*/
+voidptr vector_gap_contiguous(vector_gap_t *self) {
+    vector_gap_move(self, vector_gap_size(self));
+    return self->m_impl.m_start;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  func
+*/
+void vector_gap_foreach(vector_gap_t *self, void (*func)(void *)) {
+    const size_t elem_size = self->m_impl.m_elem_size;
+    char *it = (char *)self->m_impl.m_start;
+    char *gap_begin = cgcs_vector_gap_slot(self, self->m_gap_begin);
+    char *end = (char *)self->m_impl.m_end_of_storage;
+
+    for (; it < gap_begin; it += elem_size) {
+        func(it);
+    }
+
+    for (it = cgcs_vector_gap_slot(self, self->m_gap_end); it < end; it += elem_size) {
+        func(it);
+    }
+}
+
+void vector_gap_foreach_b(vector_gap_t *self, void (^block)(void *)) {
+    const size_t elem_size = self->m_impl.m_elem_size;
+    char *it = (char *)self->m_impl.m_start;
+    char *gap_begin = cgcs_vector_gap_slot(self, self->m_gap_begin);
+    char *end = (char *)self->m_impl.m_end_of_storage;
+
+    for (; it < gap_begin; it += elem_size) {
+        block(it);
+    }
+
+    for (it = cgcs_vector_gap_slot(self, self->m_gap_end); it < end; it += elem_size) {
+        block(it);
+    }
+}
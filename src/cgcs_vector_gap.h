@@ -0,0 +1,202 @@
+/*!
+    \file       cgcs_vector_gap.h
+    \brief      Header file for a gap buffer on vector_t storage,
+                for insertion and erasure around a moving cursor
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_GAP_H
+#define CGCS_VECTOR_GAP_H
+
+#include "cgcs_vector.h"
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_gap vector_gap_t;
+
+/*!
+    \struct
+    \brief      A vector whose free capacity sits at the edit point,
+                not at the back
+
+    The blocks live in a struct cgcs_vector_base, as a vector_t's do
+    (same allocators, same element sizes), in two runs: slots
+    [0, m_gap_begin) hold blocks [0, m_gap_begin), and slots
+    [m_gap_end, capacity) hold the rest. m_impl.m_finish is unused.
+
+    Inserting or erasing at position pos first moves the gap there,
+    which copies the |pos - m_gap_begin| blocks in between, and then
+    costs O(1). Edits that cluster around a cursor move few blocks,
+    where vector_insert and vector_erase would move the whole tail
+    every time.
+
+    Traversal follows the vector_t idiom, with vector_gap_next
+    stepping over the gap:
+
+    \code
+        for (vector_iterator_t it = vector_gap_begin(&g);
+             it != vector_gap_end(&g); it = vector_gap_next(&g, it)) {
+            ...
+        }
+    \endcode
+
+    vector_gap_contiguous moves the gap to the back, after which the
+    blocks are laid out as a vector_t's, for as long as the edits happen
+    at the back.
+*/
+struct cgcs_vector_gap {
+    struct cgcs_vector_base m_impl;
+    size_t m_gap_begin;         // first free slot; also the number of blocks before the gap
+    size_t m_gap_end;           // first slot after the gap
+};
+
+void vector_gap_init(vector_gap_t *self, size_t capacity);
+void vector_gap_init_elem(vector_gap_t *self, size_t capacity, size_t elem_size);
+void vector_gap_init_allocator(vector_gap_t *self, size_t capacity,
+                               const vector_allocator_t *alloc);
+void vector_gap_init_elem_allocator(vector_gap_t *self, size_t capacity, size_t elem_size,
+                                    const vector_allocator_t *alloc);
+
+void vector_gap_deinit(vector_gap_t *self);
+
+void vector_gap_move(vector_gap_t *self, size_t pos);
+
+voidptr vector_gap_insert(vector_gap_t *self, size_t pos, const void *valaddr);
+voidptr vector_gap_insert_n(vector_gap_t *self, size_t pos, const void *src, size_t n);
+
+void vector_gap_erase(vector_gap_t *self, size_t pos);
+void vector_gap_erase_n(vector_gap_t *self, size_t pos, size_t n);
+
+void vector_gap_push_back(vector_gap_t *self, const void *valaddr);
+
+void vector_gap_clear(vector_gap_t *self);
+
+voidptr vector_gap_contiguous(vector_gap_t *self);
+
+void vector_gap_foreach(vector_gap_t *self, void (*func)(void *));
+void vector_gap_foreach_b(vector_gap_t *self, void (^block)(void *));
+
+static voidptr vector_gap_at(vector_gap_t *self, size_t index);
+
+static vector_iterator_t vector_gap_begin(vector_gap_t *self);
+static vector_iterator_t vector_gap_end(vector_gap_t *self);
+static vector_iterator_t vector_gap_next(vector_gap_t *self, vector_iterator_t it);
+
+static size_t vector_gap_size(vector_gap_t *self);
+static size_t vector_gap_capacity(vector_gap_t *self);
+static size_t vector_gap_cursor(vector_gap_t *self);
+static bool vector_gap_empty(vector_gap_t *self);
+
+/*!
+    \brief      Returns the address of slot in self's buffer
+
+    \param[in]  self
+    \param[in]  slot
+
+    \return
+*/
+static inline voidptr cgcs_vector_gap_slot(vector_gap_t *self, size_t slot) {
+    return (voidptr)((char *)self->m_impl.m_start + slot * self->m_impl.m_elem_size);
+}
+
+/*!
+    \brief      Returns the address of block index
+
+    \param[in]  self
+    \param[in]  index
+
+    \return
+*/
+static inline voidptr vector_gap_at(vector_gap_t *self, size_t index) {
+    const size_t gap = self->m_gap_end - self->m_gap_begin;
+    return cgcs_vector_gap_slot(self, index < self->m_gap_begin ? index : index + gap);
+}
+
+/*!
+    \brief      Returns an iterator to the first block
+                (vector_gap_end(self) if there is none)
+
+    \param[in]  self
+
+    \return
+*/
+static inline vector_iterator_t vector_gap_begin(vector_gap_t *self) {
+    return cgcs_vector_gap_slot(self, self->m_gap_begin == 0 ? self->m_gap_end : 0);
+}
+
+/*!
+    \brief      Returns an iterator one past the last block
+
+    \param[in]  self
+
+    \return
+*/
+static inline vector_iterator_t vector_gap_end(vector_gap_t *self) {
+    return self->m_impl.m_end_of_storage;
+}
+
+/*!
+    \brief      Returns an iterator to the block after it, skipping the gap
+
+    \param[in]  self
+    \param[in]  it
+
+    \return
+*/
+static inline vector_iterator_t vector_gap_next(vector_gap_t *self, vector_iterator_t it) {
+    voidptr next = (char *)it + self->m_impl.m_elem_size;
+    return next == cgcs_vector_gap_slot(self, self->m_gap_begin)
+               ? cgcs_vector_gap_slot(self, self->m_gap_end)
+               : next;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_gap_size(vector_gap_t *self) {
+    return vector_gap_capacity(self) - (self->m_gap_end - self->m_gap_begin);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_gap_capacity(vector_gap_t *self) {
+    return ((char *)self->m_impl.m_end_of_storage - (char *)self->m_impl.m_start) /
+           self->m_impl.m_elem_size;
+}
+
+/*!
+    \brief      Returns the position of the gap: the number of blocks before it
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_gap_cursor(vector_gap_t *self) {
+    return self->m_gap_begin;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline bool vector_gap_empty(vector_gap_t *self) {
+    return vector_gap_size(self) == 0;
+}
+
+#endif /* CGCS_VECTOR_GAP_H */
@@ -0,0 +1,344 @@
+/*!
+    \file       cgcs_vector_image.c
+    \brief      Source file for saving a vector_t to disk, and mapping it back
+                without copying (vector_save/vector_map)
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE     // mremap
+#endif
+
+#include "cgcs_vector_image.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define CGCS_VECTOR_IMAGE_MAGIC "CGCSVEC"
+#define CGCS_VECTOR_IMAGE_VERSION 1
+#define CGCS_VECTOR_IMAGE_BYTE_ORDER 0x01020304u
+
+// Where the blocks start, in the file and in every mapping. A multiple of
+// any block alignment, and of the page size on most platforms.
+#define CGCS_VECTOR_IMAGE_DATA_OFFSET 4096
+
+// Set in the header of mappings made by the allocator (never on disk).
+#define CGCS_VECTOR_IMAGE_ANONYMOUS 1u
+
+// Bytes of encoded blocks vector_save buffers between writes.
+#define CGCS_VECTOR_IMAGE_WRITE_BUFFER (64 * 1024)
+
+/*!
+    \struct
+    \brief      The start of an image, on disk and in memory
+
+    Every buffer of cgcs_vector_image_allocator begins
+    CGCS_VECTOR_IMAGE_DATA_OFFSET bytes after one of these, which is how
+    the allocator, given only a buffer, knows how to resize or unmap it.
+*/
+struct cgcs_vector_image_header {
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_byte_order;
+    uint64_t m_flags;
+    uint64_t m_elem_size;
+    uint64_t m_size;            // blocks
+    uint64_t m_data_offset;
+    uint64_t m_map_length;      // bytes: of the file, or of the mapping
+};
+
+static void *cgcs_vector_image_allocfn(void *ctx, size_t size);
+static void *cgcs_vector_image_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void cgcs_vector_image_freefn(void *ctx, void *ptr, size_t size);
+
+const vector_allocator_t cgcs_vector_image_allocator = {
+    .m_allocfn = cgcs_vector_image_allocfn,
+    .m_reallocfn = cgcs_vector_image_reallocfn,
+    .m_freefn = cgcs_vector_image_freefn,
+    .m_ctx = NULL
+};
+
+/*!
+    \brief      Returns the header of a buffer from cgcs_vector_image_allocator
+
+    \param[in]  ptr
+
+    \return
+*/
+static inline struct cgcs_vector_image_header *cgcs_vector_image_header_of(void *ptr) {
+    return (struct cgcs_vector_image_header *)((char *)ptr - CGCS_VECTOR_IMAGE_DATA_OFFSET);
+}
+
+/*!
+    \brief      Returns the length of an anonymous mapping for size bytes of blocks
+
+    \param[in]  size
+
+    \return
+*/
+static inline size_t cgcs_vector_image_anon_length(size_t size) {
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    return (CGCS_VECTOR_IMAGE_DATA_OFFSET + size + page - 1) & ~(page - 1);
+}
+
+/*!
+    \brief      Fills in the fields of header common to files and mappings
+
+    \param[in]  header
+*/
+static void cgcs_vector_image_header_init(struct cgcs_vector_image_header *header) {
+    memset(header, 0, sizeof *header);
+    memcpy(header->m_magic, CGCS_VECTOR_IMAGE_MAGIC, sizeof CGCS_VECTOR_IMAGE_MAGIC);
+    header->m_version = CGCS_VECTOR_IMAGE_VERSION;
+    header->m_byte_order = CGCS_VECTOR_IMAGE_BYTE_ORDER;
+    header->m_data_offset = CGCS_VECTOR_IMAGE_DATA_OFFSET;
+}
+
+static void *cgcs_vector_image_allocfn(void *ctx, size_t size) {
+    const size_t length = cgcs_vector_image_anon_length(size);
+    struct cgcs_vector_image_header *header =
+        mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (header == MAP_FAILED) {
+        return NULL;
+    }
+
+    cgcs_vector_image_header_init(header);
+    header->m_flags = CGCS_VECTOR_IMAGE_ANONYMOUS;
+    header->m_map_length = length;
+
+    return (char *)header + CGCS_VECTOR_IMAGE_DATA_OFFSET;
+}
+
+/*!
+    \brief      Resizes a buffer of the allocator
+
+    A mapped file cannot grow in private memory, so the first time
+    a vector outgrows its image, its blocks move to an anonymous
+    mapping (the only copy they ever see). Anonymous mappings are
+    resized with mremap, which does not copy.
+
+    \param[in]  ctx
+    \param[in]  ptr
+    \param[in]  old_size
+    \param[in]  new_size
+
+    \return
+*/
+static void *cgcs_vector_image_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    struct cgcs_vector_image_header *header = cgcs_vector_image_header_of(ptr);
+    const size_t new_length = cgcs_vector_image_anon_length(new_size);
+    void *moved = NULL;
+
+    if (new_size <= old_size && (header->m_flags & CGCS_VECTOR_IMAGE_ANONYMOUS) == 0) {
+        // Shrinking an image: its pages are only touched if written to.
+        return ptr;
+    }
+
+#if defined(__linux__)
+    if (header->m_flags & CGCS_VECTOR_IMAGE_ANONYMOUS) {
+        header = mremap(header, header->m_map_length, new_length, MREMAP_MAYMOVE);
+
+        if (header == MAP_FAILED) {
+            return NULL;
+        }
+
+        header->m_map_length = new_length;
+        return (char *)header + CGCS_VECTOR_IMAGE_DATA_OFFSET;
+    }
+#endif
+
+    moved = cgcs_vector_image_allocfn(ctx, new_size);
+
+    if (moved == NULL) {
+        return NULL;
+    }
+
+    memcpy(moved, ptr, old_size < new_size ? old_size : new_size);
+    munmap(header, header->m_map_length);
+
+    return moved;
+}
+
+static void cgcs_vector_image_freefn(void *ctx, void *ptr, size_t size) {
+    struct cgcs_vector_image_header *header = cgcs_vector_image_header_of(ptr);
+    munmap(header, header->m_map_length);
+}
+
+/*!
+    \brief      Writes all n bytes at buf to fd
+
+    \param[in]  fd
+    \param[in]  buf
+    \param[in]  n
+
+    \return     false on error (see errno)
+*/
+static bool cgcs_vector_image_write(int fd, const void *buf, size_t n) {
+    const char *pos = buf;
+
+    while (n > 0) {
+        const ssize_t written = write(fd, pos, n);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        pos += written;
+        n -= (size_t)written;
+    }
+
+    return true;
+}
+
+/*!
+    \brief      Writes an image of self to fd, for vector_map to load
+
+    The image is written at fd's current offset; vector_map expects
+    a file that holds exactly one image, from its start.
+
+    \param[in]  self
+    \param[in]  fd
+    \param[in]  encodefn    if not NULL, called on every block to write
+                            its on-disk form (vector_elem_size(self) bytes)
+                            to dst; if NULL, the blocks are written as they are
+
+    \return     false on error (see errno)
+*/
+bool vector_save(vector_t *self, int fd, void (*encodefn)(void *dst, const void *block)) {
+    const size_t elem_size = vector_elem_size(self);
+    const size_t size = vector_size(self);
+    char page[CGCS_VECTOR_IMAGE_DATA_OFFSET] = { 0 };
+    struct cgcs_vector_image_header header;
+    char *buffer = NULL;
+    size_t per_buffer = 0;
+    bool ok = true;
+
+    cgcs_vector_image_header_init(&header);
+    header.m_elem_size = elem_size;
+    header.m_size = size;
+    header.m_map_length = CGCS_VECTOR_IMAGE_DATA_OFFSET + (uint64_t)elem_size * size;
+    memcpy(page, &header, sizeof header);
+
+    if (cgcs_vector_image_write(fd, page, sizeof page) == false) {
+        return false;
+    }
+
+    if (encodefn == NULL) {
+        return cgcs_vector_image_write(fd, vector_begin(self), elem_size * size);
+    }
+
+    per_buffer = CGCS_VECTOR_IMAGE_WRITE_BUFFER / elem_size;
+    per_buffer = per_buffer > 0 ? per_buffer : 1;
+
+    buffer = malloc(elem_size * per_buffer);
+    assert(buffer);
+
+    for (size_t first = 0; ok && first < size; first += per_buffer) {
+        const size_t n = size - first < per_buffer ? size - first : per_buffer;
+        vector_iterator_t it = vector_advance(self, vector_begin(self), first);
+
+        for (size_t i = 0; i < n; i++, it = vector_advance(self, it, 1)) {
+            encodefn(buffer + elem_size * i, it);
+        }
+
+        ok = cgcs_vector_image_write(fd, buffer, elem_size * n);
+    }
+
+    free(buffer);
+    return ok;
+}
+
+/*!
+    \brief      Initializes self as a view of the image at path,
+                mapped (MAP_PRIVATE) rather than read
+
+    Loading costs one mmap, whatever the size of the image; pages are
+    read from the page cache as blocks are first touched. self is an
+    ordinary vector_t from then on: it may be read, written (writes stay
+    private), grown (see cgcs_vector_image_allocator) and must be
+    released with vector_deinit.
+
+    \param[in]  self
+    \param[in]  path
+
+    \return     false if path cannot be mapped, or is not an image
+                written by vector_save (errno is EINVAL); self is then
+                left uninitialized
+*/
+bool vector_map(vector_t *self, const char *path) {
+    struct cgcs_vector_image_header *header = NULL;
+    struct stat st;
+    size_t length = 0;
+    char *start = NULL;
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    length = (size_t)st.st_size;
+
+    if (length < CGCS_VECTOR_IMAGE_DATA_OFFSET) {
+        close(fd);
+        errno = EINVAL;
+        return false;
+    }
+
+    // Writable, but private: writes go to copies of the pages, not to the file.
+    header = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (header == MAP_FAILED) {
+        return false;
+    }
+
+    if (memcmp(header->m_magic, CGCS_VECTOR_IMAGE_MAGIC, sizeof CGCS_VECTOR_IMAGE_MAGIC) != 0 ||
+        header->m_version != CGCS_VECTOR_IMAGE_VERSION ||
+        header->m_byte_order != CGCS_VECTOR_IMAGE_BYTE_ORDER ||
+        header->m_flags != 0 ||
+        header->m_data_offset != CGCS_VECTOR_IMAGE_DATA_OFFSET ||
+        header->m_elem_size == 0 ||
+        header->m_map_length != length ||
+        header->m_size != (length - CGCS_VECTOR_IMAGE_DATA_OFFSET) / header->m_elem_size ||
+        (length - CGCS_VECTOR_IMAGE_DATA_OFFSET) % header->m_elem_size != 0) {
+        munmap(header, length);
+        errno = EINVAL;
+        return false;
+    }
+
+    start = (char *)header + CGCS_VECTOR_IMAGE_DATA_OFFSET;
+
+    self->m_impl.m_start = (voidptr *)start;
+    self->m_impl.m_finish = (voidptr *)(start + header->m_elem_size * header->m_size);
+    self->m_impl.m_end_of_storage = self->m_impl.m_finish;
+    self->m_impl.m_elem_size = header->m_elem_size;
+    self->m_impl.m_inline = NULL;
+    self->m_impl.m_alloc = &cgcs_vector_image_allocator;
+
+    vector_set_growth(self, CGCS_VECTOR_GROWTH_FACTOR_2, 0);
+    vector_set_fill(self, CGCS_VECTOR_FILL_ZERO);
+    self->m_index = NULL;
+
+    return true;
+}
@@ -0,0 +1,45 @@
+/*!
+    \file       cgcs_vector_image.h
+    \brief      Header file for saving a vector_t to disk, and mapping it back
+                without copying (vector_save/vector_map)
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_IMAGE_H
+#define CGCS_VECTOR_IMAGE_H
+
+#include "cgcs_vector.h"
+
+/*
+    An image is a 4 KiB header (magic "CGCSVEC", format version,
+    byte order, element size, number of blocks), followed by the blocks
+    themselves, exactly as they are laid out in a vector's buffer.
+    Images are only readable on machines with the byte order they were
+    written with.
+
+    vector_map maps an image (MAP_PRIVATE) and points a vector_t at its
+    blocks: vector_begin, vector_i, vector_find, vector_bsearch, ...
+    read the page cache directly, and nothing is copied at load time.
+    Blocks written through the vector get private copies of their pages
+    from the kernel; the file is never modified.
+
+    Such a vector uses cgcs_vector_image_allocator. The first time it
+    outgrows the image, its blocks are copied to an anonymous mapping,
+    which grows with mremap from then on. vector_deinit unmaps it.
+
+    Pointers are meaningless in another process: save vectors of
+    offsets or integers (vector_init_elem), or give vector_save an
+    encodefn that turns each pointer into something that is not.
+*/
+
+/*!
+    \brief      The allocator of the vectors made with vector_map
+*/
+extern const vector_allocator_t cgcs_vector_image_allocator;
+
+bool vector_save(vector_t *self, int fd, void (*encodefn)(void *dst, const void *block));
+bool vector_map(vector_t *self, const char *path);
+
+#endif /* CGCS_VECTOR_IMAGE_H */
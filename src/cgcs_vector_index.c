@@ -0,0 +1,407 @@
+/*!
+    \file       cgcs_vector_index.c
+    \brief      Source file for a hash index kept alongside a vector_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_index_impl.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+// Marks a slot of the table as empty.
+#define CGCS_VECTOR_INDEX_EMPTY SIZE_MAX
+
+// Smallest table. Tables are kept at most half full, so probe runs stay short.
+#define CGCS_VECTOR_INDEX_MIN_SLOTS 16
+
+/*!
+    \struct
+    \brief      One slot of the table: a (mixed) hash and the position
+                of the block it was computed from
+*/
+struct cgcs_vector_index_slot {
+    uint64_t m_hash;
+    size_t m_pos;
+};
+
+/*!
+    \struct
+    \brief      Open-addressing (linear probing) table from hash to position
+
+    Allocated from, and freed to, the allocator of the vector it indexes.
+*/
+struct cgcs_vector_index {
+    uint64_t (*m_hashfn)(const void *);
+    int (*m_cmpfn)(const void *, const void *);
+
+    struct cgcs_vector_index_slot *m_slots;
+    size_t m_mask;              // number of slots - 1 (a power of 2)
+    size_t m_count;
+};
+
+/*!
+    \brief      Spreads the bits of a caller's hash over all 64 bits
+                (MurmurHash3's finalizer), so weak hashes such as
+                the identity still probe well
+
+    \param[in]  hash
+
+    \return
+*/
+static inline uint64_t cgcs_vector_index_mix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+static inline uint64_t
+cgcs_vector_index_hash(vector_t *self, size_t pos) {
+    const vector_iterator_t it = vector_advance(self, vector_begin(self), pos);
+    return cgcs_vector_index_mix(self->m_index->m_hashfn(it));
+}
+
+/*!
+    \brief      Replaces the table of index with an empty one of nslots slots
+
+    \param[in]  self
+    \param[in]  nslots  a power of 2
+*/
+static void
+cgcs_vector_index_new_slots(vector_t *self, size_t nslots) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    struct cgcs_vector_index *index = self->m_index;
+
+    index->m_slots = alloc->m_allocfn(alloc->m_ctx, sizeof *index->m_slots * nslots);
+    assert(index->m_slots);
+
+    index->m_mask = nslots - 1;
+    index->m_count = 0;
+
+    for (size_t i = 0; i < nslots; i++) {
+        index->m_slots[i].m_pos = CGCS_VECTOR_INDEX_EMPTY;
+    }
+}
+
+static void
+cgcs_vector_index_delete_slots(vector_t *self) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    struct cgcs_vector_index *index = self->m_index;
+
+    alloc->m_freefn(alloc->m_ctx, index->m_slots, sizeof *index->m_slots * (index->m_mask + 1));
+    index->m_slots = NULL;
+}
+
+/*!
+    \brief      Adds (hash, pos) to the table, which must have a free slot
+
+    \param[in]  index
+    \param[in]  hash
+    \param[in]  pos
+*/
+static inline void
+cgcs_vector_index_put(struct cgcs_vector_index *index, uint64_t hash, size_t pos) {
+    size_t i = hash & index->m_mask;
+
+    while (index->m_slots[i].m_pos != CGCS_VECTOR_INDEX_EMPTY) {
+        i = (i + 1) & index->m_mask;
+    }
+
+    index->m_slots[i].m_hash = hash;
+    index->m_slots[i].m_pos = pos;
+    ++index->m_count;
+}
+
+/*!
+    \brief      Resizes the table to nslots slots,
+                re-inserting every entry from its stored hash
+
+    \param[in]  self
+    \param[in]  nslots  a power of 2, more than twice the number of entries
+*/
+static void
+cgcs_vector_index_rehash(vector_t *self, size_t nslots) {
+    struct cgcs_vector_index *index = self->m_index;
+    struct cgcs_vector_index_slot *old = index->m_slots;
+    const size_t old_nslots = index->m_mask + 1;
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+
+    cgcs_vector_index_new_slots(self, nslots);
+
+    for (size_t i = 0; i < old_nslots; i++) {
+        if (old[i].m_pos != CGCS_VECTOR_INDEX_EMPTY) {
+            cgcs_vector_index_put(index, old[i].m_hash, old[i].m_pos);
+        }
+    }
+
+    alloc->m_freefn(alloc->m_ctx, old, sizeof *old * old_nslots);
+}
+
+/*!
+    \brief      Removes the entry for position pos, whose hash is hash
+
+    Uses backward-shift deletion: later entries of the probe run
+    are moved up, so the table never holds tombstones.
+
+    \param[in]  index
+    \param[in]  hash
+    \param[in]  pos
+*/
+static void
+cgcs_vector_index_remove(struct cgcs_vector_index *index, uint64_t hash, size_t pos) {
+    const size_t mask = index->m_mask;
+    size_t i = hash & mask;
+    size_t j = 0;
+
+    while (index->m_slots[i].m_pos != pos) {
+        assert(index->m_slots[i].m_pos != CGCS_VECTOR_INDEX_EMPTY);
+        i = (i + 1) & mask;
+    }
+
+    for (j = (i + 1) & mask; index->m_slots[j].m_pos != CGCS_VECTOR_INDEX_EMPTY;
+         j = (j + 1) & mask) {
+        const size_t home = index->m_slots[j].m_hash & mask;
+
+        // The entry at j may fill the hole at i only if its home slot
+        // does not lie cyclically within (i, j].
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            index->m_slots[i] = index->m_slots[j];
+            i = j;
+        }
+    }
+
+    index->m_slots[i].m_pos = CGCS_VECTOR_INDEX_EMPTY;
+    --index->m_count;
+}
+
+/*!
+    \brief      Adds delta to every position at or after from
+
+    \param[in]  index
+    \param[in]  from
+    \param[in]  delta
+*/
+static void
+cgcs_vector_index_shift(struct cgcs_vector_index *index, size_t from, ptrdiff_t delta) {
+    for (size_t i = 0; i <= index->m_mask; i++) {
+        struct cgcs_vector_index_slot *slot = &index->m_slots[i];
+
+        if (slot->m_pos != CGCS_VECTOR_INDEX_EMPTY && slot->m_pos >= from) {
+            slot->m_pos += delta;
+        }
+    }
+}
+
+/*!
+    \brief      Returns the smallest power of 2 of at least
+                CGCS_VECTOR_INDEX_MIN_SLOTS slots that keeps n entries
+                at most half full
+
+    \param[in]  n
+
+    \return
+*/
+static inline size_t cgcs_vector_index_nslots(size_t n) {
+    size_t nslots = CGCS_VECTOR_INDEX_MIN_SLOTS;
+
+    while (nslots < n * 2) {
+        nslots *= 2;
+    }
+
+    return nslots;
+}
+
+/*!
+    \brief      Attaches an index to self, and indexes every block in it
+
+    hashfn and cmpfn are called with a block's address (like the
+    comparators of vector_find) or with the valaddr given to
+    vector_find_indexed. Blocks that compare equal must hash equally.
+
+    If self already has an index, it is replaced.
+    The index is freed by vector_index_detach or vector_deinit.
+
+    \param[in]  self
+    \param[in]  hashfn
+    \param[in]  cmpfn
+*/
+void vector_index_attach(vector_t *self, uint64_t (*hashfn)(const void *),
+                         int (*cmpfn)(const void *, const void *)) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+
+    vector_index_detach(self);
+
+    self->m_index = alloc->m_allocfn(alloc->m_ctx, sizeof *self->m_index);
+    assert(self->m_index);
+
+    self->m_index->m_hashfn = hashfn;
+    self->m_index->m_cmpfn = cmpfn;
+    self->m_index->m_slots = NULL;
+
+    vector_index_rebuild(self);
+}
+
+/*!
+    \brief      Frees the index of self, if it has one
+
+    \param[in]  self
+*/
+void vector_index_detach(vector_t *self) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+
+    if (self->m_index) {
+        cgcs_vector_index_delete_slots(self);
+        alloc->m_freefn(alloc->m_ctx, self->m_index, sizeof *self->m_index);
+        self->m_index = NULL;
+    }
+}
+
+/*!
+    \brief      Re-indexes every block of self in one pass
+
+    The table is sized for vector_size(self) up front,
+    so it is not grown while the blocks are hashed.
+
+    \param[in]  self
+*/
+void vector_index_rebuild(vector_t *self) {
+    const size_t size = vector_size(self);
+
+    if (self->m_index == NULL) {
+        return;
+    }
+
+    if (self->m_index->m_slots) {
+        cgcs_vector_index_delete_slots(self);
+    }
+
+    cgcs_vector_index_new_slots(self, cgcs_vector_index_nslots(size));
+
+    for (size_t pos = 0; pos < size; pos++) {
+        cgcs_vector_index_put(self->m_index, cgcs_vector_index_hash(self, pos), pos);
+    }
+}
+
+/*!
+    \brief      Finds the first block equal to *valaddr, by way of the index
+
+    \param[in]  self
+    \param[in]  valaddr
+
+    \return     iterator to the block, or NULL if there is none
+*/
+vector_iterator_t vector_find_indexed(vector_t *self, const void *valaddr) {
+    struct cgcs_vector_index *index = self->m_index;
+    uint64_t hash = 0;
+    size_t first = CGCS_VECTOR_INDEX_EMPTY;
+
+    assert(index);
+
+    hash = cgcs_vector_index_mix(index->m_hashfn(valaddr));
+
+    // Equal blocks share a probe run; keep looking for the one
+    // nearest the front, as vector_find would return.
+    for (size_t i = hash & index->m_mask; index->m_slots[i].m_pos != CGCS_VECTOR_INDEX_EMPTY;
+         i = (i + 1) & index->m_mask) {
+        const struct cgcs_vector_index_slot *slot = &index->m_slots[i];
+
+        if (slot->m_hash == hash && slot->m_pos < first &&
+            index->m_cmpfn(vector_advance(self, vector_begin(self), slot->m_pos), valaddr) == 0) {
+            first = slot->m_pos;
+        }
+    }
+
+    return first == CGCS_VECTOR_INDEX_EMPTY ? NULL
+                                            : vector_advance(self, vector_begin(self), first);
+}
+
+/*!
+    \brief      Indexes the n blocks now at [pos, pos + n),
+                moving the entries of the blocks after them
+
+    Called once the blocks are in place.
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  n
+*/
+void cgcs_vector_index_insert(vector_t *self, size_t pos, size_t n) {
+    struct cgcs_vector_index *index = self->m_index;
+
+    if ((index->m_count + n) * 2 > index->m_mask + 1) {
+        cgcs_vector_index_rehash(self, cgcs_vector_index_nslots(index->m_count + n));
+    }
+
+    if (pos + n < vector_size(self)) {
+        cgcs_vector_index_shift(index, pos, (ptrdiff_t)n);
+    }
+
+    for (size_t i = pos; i < pos + n; i++) {
+        cgcs_vector_index_put(index, cgcs_vector_index_hash(self, i), i);
+    }
+}
+
+/*!
+    \brief      Drops the n blocks at [pos, pos + n) from the index,
+                moving the entries of the blocks after them
+
+    Called before the blocks are removed, while they can still be hashed.
+
+    \param[in]  self
+    \param[in]  pos
+    \param[in]  n
+*/
+void cgcs_vector_index_erase(vector_t *self, size_t pos, size_t n) {
+    struct cgcs_vector_index *index = self->m_index;
+
+    for (size_t i = pos; i < pos + n; i++) {
+        cgcs_vector_index_remove(index, cgcs_vector_index_hash(self, i), i);
+    }
+
+    if (pos + n < vector_size(self)) {
+        cgcs_vector_index_shift(index, pos + n, -(ptrdiff_t)n);
+    }
+}
+
+/*!
+    \brief      Drops the block at to from the index, and re-indexes
+                the block at from as being at to
+
+    Called before the block at from is copied over the block at to
+    (vector_erase_unordered), while both can still be hashed.
+    No other entry moves.
+
+    \param[in]  self
+    \param[in]  from
+    \param[in]  to
+*/
+void cgcs_vector_index_move(vector_t *self, size_t from, size_t to) {
+    struct cgcs_vector_index *index = self->m_index;
+    const uint64_t hash = cgcs_vector_index_hash(self, from);
+
+    cgcs_vector_index_remove(index, cgcs_vector_index_hash(self, to), to);
+    cgcs_vector_index_remove(index, hash, from);
+    cgcs_vector_index_put(index, hash, to);
+}
+
+/*!
+    \brief      Empties the index (keeping its table)
+
+    \param[in]  self
+*/
+void cgcs_vector_index_clear(vector_t *self) {
+    struct cgcs_vector_index *index = self->m_index;
+
+    for (size_t i = 0; i <= index->m_mask; i++) {
+        index->m_slots[i].m_pos = CGCS_VECTOR_INDEX_EMPTY;
+    }
+
+    index->m_count = 0;
+}
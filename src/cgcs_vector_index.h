@@ -0,0 +1,36 @@
+/*!
+    \file       cgcs_vector_index.h
+    \brief      Header file for a hash index kept alongside a vector_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_INDEX_H
+#define CGCS_VECTOR_INDEX_H
+
+#include "cgcs_vector.h"
+
+/*
+    A vector with an index attached keeps, next to its buffer, an
+    open-addressing hash table from the hash of each block to its position.
+
+    vector_push_back, vector_append_n, vector_commit_back, vector_insert(_range),
+    vector_erase(_range), vector_pop_back, vector_clear and the vector_*sort*
+    family keep the index up to date. Appending and popping cost O(1) more;
+    inserting or erasing before the last block costs a pass over the table,
+    since every position after it moves.
+
+    Writing blocks through iterators (or vector_reserve_back without
+    vector_commit_back) bypasses the index: call vector_index_rebuild afterwards.
+*/
+
+void vector_index_attach(vector_t *self, uint64_t (*hashfn)(const void *),
+                         int (*cmpfn)(const void *, const void *));
+void vector_index_detach(vector_t *self);
+
+void vector_index_rebuild(vector_t *self);
+
+vector_iterator_t vector_find_indexed(vector_t *self, const void *valaddr);
+
+#endif /* CGCS_VECTOR_INDEX_H */
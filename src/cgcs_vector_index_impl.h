@@ -0,0 +1,26 @@
+/*!
+    \file       cgcs_vector_index_impl.h
+    \brief      Private header for the hooks that keep a vector's hash index
+                up to date; included only by the library's own sources
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_INDEX_IMPL_H
+#define CGCS_VECTOR_INDEX_IMPL_H
+
+#include "cgcs_vector_index.h"
+
+/*
+    Called by the vector functions that move blocks, and only when
+    self->m_index is non-NULL. Users must not call these directly:
+    see vector_index_rebuild instead.
+*/
+
+void cgcs_vector_index_insert(vector_t *self, size_t pos, size_t n);
+void cgcs_vector_index_erase(vector_t *self, size_t pos, size_t n);
+void cgcs_vector_index_move(vector_t *self, size_t from, size_t to);
+void cgcs_vector_index_clear(vector_t *self);
+
+#endif /* CGCS_VECTOR_INDEX_IMPL_H */
@@ -0,0 +1,242 @@
+/*!
+    \file       cgcs_vector_mmap.c
+    \brief      Source file for an mmap-backed allocator for huge vector_t buffers
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE     // mremap
+#endif
+
+#include "cgcs_vector_mmap.h"
+
+#include <assert.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#if !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+// Transparent huge pages on x86-64 and arm64 (with 4 KiB base pages).
+#define CGCS_VECTOR_MMAP_HUGE_PAGE_SIZE ((size_t)2 << 20)
+
+static void *cgcs_vector_mmap_allocfn(void *ctx, size_t size);
+static void *cgcs_vector_mmap_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size);
+static void cgcs_vector_mmap_freefn(void *ctx, void *ptr, size_t size);
+
+/*!
+    \brief      Rounds size up to a multiple of granule (a power of 2)
+
+    \param[in]  size
+    \param[in]  granule
+
+    \return
+*/
+static inline size_t cgcs_vector_mmap_round(size_t size, size_t granule) {
+    return (size + granule - 1) & ~(granule - 1);
+}
+
+/*!
+    \brief      Returns the length of the mapping behind a buffer of size bytes
+
+    Depends on size alone, so the allocator needs no record of its mappings:
+    freefn and reallocfn recompute it from the size they are given.
+
+    \param[in]  self
+    \param[in]  size
+
+    \return
+*/
+static inline size_t cgcs_vector_mmap_length(vector_mmap_t *self, size_t size) {
+    const size_t length = cgcs_vector_mmap_round(size > 0 ? size : 1, self->m_granule);
+    return length > self->m_reserve ? length : self->m_reserve;
+}
+
+/*!
+    \brief      Advises the kernel to back [ptr, ptr + length) with huge pages,
+                if self asks for them (and the platform has them)
+
+    \param[in]  self
+    \param[in]  ptr
+    \param[in]  length
+*/
+static inline void cgcs_vector_mmap_advise(vector_mmap_t *self, void *ptr, size_t length) {
+#if defined(MADV_HUGEPAGE)
+    if (self->m_flags & CGCS_VECTOR_MMAP_HUGEPAGES) {
+        // Only advice: failing to get huge pages is not an error.
+        madvise(ptr, length, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+/*!
+    \brief      Maps length bytes of zeroed, private memory,
+                aligned to self->m_granule
+
+    \param[in]  self
+    \param[in]  length  a multiple of self->m_granule
+
+    \return     the mapping, or NULL
+*/
+static void *cgcs_vector_mmap_map(vector_mmap_t *self, size_t length) {
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *raw = NULL;
+    char *aligned = NULL;
+
+    if (self->m_granule <= page) {
+        raw = mmap(NULL, length, prot, flags, -1, 0);
+        return raw == MAP_FAILED ? NULL : raw;
+    }
+
+    // mmap only aligns to a page: map a granule more than needed,
+    // then unmap whatever lies outside the aligned range.
+    raw = mmap(NULL, length + self->m_granule, prot, flags, -1, 0);
+
+    if (raw == MAP_FAILED) {
+        return NULL;
+    }
+
+    aligned = (char *)cgcs_vector_mmap_round((size_t)raw, self->m_granule);
+
+    if (aligned > raw) {
+        munmap(raw, aligned - raw);
+    }
+
+    munmap(aligned + length, raw + self->m_granule - aligned);
+
+    cgcs_vector_mmap_advise(self, aligned, length);
+    return aligned;
+}
+
+/*!
+    \brief      Initializes the allocator
+
+    Every buffer is mapped with at least reserve bytes, so a vector
+    grows in place until it outgrows them. Reserving address space
+    is cheap on 64-bit platforms; reserving more than a vector will
+    ever need is the way to make its growth free.
+
+    \param[in]  self
+    \param[in]  reserve     bytes; 0 to map each buffer at its size
+    \param[in]  flags       enum cgcs_vector_mmap_flags, or'd together
+*/
+void vector_mmap_init(vector_mmap_t *self, size_t reserve, int flags) {
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    self->m_flags = flags;
+    self->m_granule = page;
+
+    if ((flags & CGCS_VECTOR_MMAP_HUGEPAGES) && CGCS_VECTOR_MMAP_HUGE_PAGE_SIZE > page) {
+        self->m_granule = CGCS_VECTOR_MMAP_HUGE_PAGE_SIZE;
+    }
+
+    self->m_reserve = cgcs_vector_mmap_round(reserve, self->m_granule);
+
+    self->m_alloc.m_allocfn = cgcs_vector_mmap_allocfn;
+    self->m_alloc.m_reallocfn = cgcs_vector_mmap_reallocfn;
+    self->m_alloc.m_freefn = cgcs_vector_mmap_freefn;
+    self->m_alloc.m_ctx = self;
+}
+
+static void *cgcs_vector_mmap_allocfn(void *ctx, size_t size) {
+    vector_mmap_t *self = ctx;
+    return cgcs_vector_mmap_map(self, cgcs_vector_mmap_length(self, size));
+}
+
+/*!
+    \brief      Resizes the buffer at ptr without copying its contents
+
+    Within the same mapping length (i.e. within the reservation),
+    growing does nothing, and shrinking hands the pages past new_size
+    back to the kernel with madvise(MADV_DONTNEED). Otherwise the
+    mapping itself is resized with mremap, which may move it to another
+    address (aligned to self->m_granule), but never copies it.
+
+    \param[in]  ctx
+    \param[in]  ptr
+    \param[in]  old_size
+    \param[in]  new_size
+
+    \return
+*/
+static void *cgcs_vector_mmap_reallocfn(void *ctx, void *ptr, size_t old_size, size_t new_size) {
+    vector_mmap_t *self = ctx;
+    const size_t old_length = cgcs_vector_mmap_length(self, old_size);
+    const size_t new_length = cgcs_vector_mmap_length(self, new_size);
+    void *moved = NULL;
+
+    if (old_length == new_length) {
+        const size_t keep = cgcs_vector_mmap_round(new_size, self->m_granule);
+        const size_t used = cgcs_vector_mmap_round(old_size, self->m_granule);
+
+        if (keep < used) {
+            madvise((char *)ptr + keep, used - keep, MADV_DONTNEED);
+        }
+
+        return ptr;
+    }
+
+#if defined(__linux__)
+    if (self->m_granule > (size_t)sysconf(_SC_PAGESIZE) && new_length > old_length) {
+        // MREMAP_MAYMOVE would only keep page alignment: grow in place
+        // if the addresses past the mapping are free, otherwise move it
+        // over an aligned mapping reserved for it.
+        moved = mremap(ptr, old_length, new_length, 0);
+
+        if (moved == MAP_FAILED) {
+            void *target = cgcs_vector_mmap_map(self, new_length);
+
+            if (target == NULL) {
+                return NULL;
+            }
+
+            moved = mremap(ptr, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+
+            if (moved == MAP_FAILED) {
+                munmap(target, new_length);
+                return NULL;
+            }
+        }
+    } else {
+        moved = mremap(ptr, old_length, new_length, MREMAP_MAYMOVE);
+
+        if (moved == MAP_FAILED) {
+            return NULL;
+        }
+    }
+
+    cgcs_vector_mmap_advise(self, moved, new_length);
+#else
+    // Without mremap, only shrinking avoids a copy.
+    if (new_length < old_length) {
+        munmap((char *)ptr + new_length, old_length - new_length);
+        return ptr;
+    }
+
+    moved = cgcs_vector_mmap_map(self, new_length);
+
+    if (moved == NULL) {
+        return NULL;
+    }
+
+    memcpy(moved, ptr, old_size);
+    munmap(ptr, old_length);
+#endif
+
+    return moved;
+}
+
+static void cgcs_vector_mmap_freefn(void *ctx, void *ptr, size_t size) {
+    vector_mmap_t *self = ctx;
+    munmap(ptr, cgcs_vector_mmap_length(self, size));
+}
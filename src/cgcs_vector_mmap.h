@@ -0,0 +1,75 @@
+/*!
+    \file       cgcs_vector_mmap.h
+    \brief      Header file for an mmap-backed allocator for huge vector_t buffers
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_MMAP_H
+#define CGCS_VECTOR_MMAP_H
+
+#include "cgcs_vector.h"
+
+/*!
+    \enum
+    \brief      Options for vector_mmap_init (may be or'd together)
+*/
+enum cgcs_vector_mmap_flags {
+    CGCS_VECTOR_MMAP_DEFAULT = 0,
+    CGCS_VECTOR_MMAP_HUGEPAGES = 1 << 0     // align to 2 MiB, and madvise(MADV_HUGEPAGE)
+};
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_mmap vector_mmap_t;
+
+/*!
+    \struct
+    \brief      An allocator that maps every buffer straight from the kernel
+
+    Meant for vectors of hundreds of millions of blocks, whose buffers
+    must never be copied. Vectors initialized with vector_init_allocator(&v,
+    capacity, vector_mmap_allocator(&mm)) get:
+
+    - a mapping of at least m_reserve bytes (rounded up to pages) from
+      the start. Pages are only backed by memory once they are touched,
+      so a vector can grow within its reservation without the allocator
+      doing anything at all.
+    - growth past the reservation through mremap(MREMAP_MAYMOVE),
+      which moves page tables, not blocks. With CGCS_VECTOR_MMAP_HUGEPAGES,
+      a moved buffer lands on a 2 MiB-aligned address (MREMAP_FIXED).
+    - vector_shrink_to_fit returning memory with madvise(MADV_DONTNEED)
+      within the reservation, and with mremap past it -- again without
+      copying a block.
+
+    Each buffer is at least one page (one huge page, with
+    CGCS_VECTOR_MMAP_HUGEPAGES), so small vectors are better off with malloc.
+    The allocator keeps no per-buffer state: it addresses itself through
+    m_alloc.m_ctx, so it must not be moved or copied once initialized.
+*/
+struct cgcs_vector_mmap {
+    size_t m_granule;       // mappings are a multiple of this (a page, or a huge page)
+    size_t m_reserve;       // bytes mapped per buffer, at least
+    int m_flags;            // enum cgcs_vector_mmap_flags
+    vector_allocator_t m_alloc;
+};
+
+void vector_mmap_init(vector_mmap_t *self, size_t reserve, int flags);
+
+static const vector_allocator_t *vector_mmap_allocator(vector_mmap_t *self);
+
+/*!
+    \brief      Returns the allocator to give to vector_init_allocator
+
+    \param[in]  self
+
+    \return
+*/
+static inline const vector_allocator_t *vector_mmap_allocator(vector_mmap_t *self) {
+    return &(self->m_alloc);
+}
+
+#endif /* CGCS_VECTOR_MMAP_H */
@@ -0,0 +1,849 @@
+/*!
+    \file       cgcs_vector_parallel.c
+    \brief      Source file for multithreaded algorithms over vector_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_parallel.h"
+#include "cgcs_vector_index.h"
+#include "cgcs_vector_pool.h"
+#include "cgcs_vector_sort.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Ranges shorter than this (per thread) are not worth a thread.
+#define CGCS_VECTOR_PARALLEL_GRAIN 4096
+
+// Chunks handed out by vector_foreach_parallel start on this boundary,
+// so that no two threads write to the same cache line.
+#define CGCS_VECTOR_PARALLEL_CACHE_LINE 64
+
+typedef int (*cgcs_vector_cmpfn)(const void *, const void *);
+
+#define cgcs_vector_less(cmp, a, b) ((cmp)((a), (b)) < 0)
+
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_parallel_sort_fn, voidptr, cgcs_vector_cmpfn, cgcs_vector_less)
+
+/*!
+    \struct
+    \brief      One slice of a merge round: out = merge([a, a_last), [b, b_last))
+*/
+struct cgcs_vector_parallel_merge {
+    voidptr *m_a;
+    voidptr *m_a_last;
+    voidptr *m_b;
+    voidptr *m_b_last;
+    voidptr *m_out;
+};
+
+/*!
+    \struct
+    \brief      State shared by the threads of one vector_parallel_*sort* call
+*/
+struct cgcs_vector_parallel_sort {
+    cgcs_vector_cmpfn m_cmpfn;
+    bool m_stable;
+
+    voidptr *m_src;             // runs being read
+    voidptr *m_scratch;         // same length as m_src
+
+    size_t *m_bounds;           // run i is [m_bounds[i], m_bounds[i + 1])
+    size_t m_nruns;
+
+    struct cgcs_vector_parallel_merge *m_merges;
+    size_t m_nmerges;
+    size_t m_nthreads;
+};
+
+/*!
+    \struct
+    \brief      State shared by the threads of one vector_parallel_radix_sort_by_key call
+
+    Thread t owns chunk t, [m_bounds[t], m_bounds[t + 1]), of m_src,
+    and m_hist[t], the digit counts of that chunk.
+*/
+struct cgcs_vector_parallel_radix {
+    uint64_t (*m_keyfn)(const void *);
+    vector_iterator_t m_pos;
+
+    struct cgcs_vector_radix_item *m_src;
+    struct cgcs_vector_radix_item *m_dst;
+
+    size_t *m_bounds;
+    size_t (*m_hist)[CGCS_VECTOR_RADIX_PASSES][CGCS_VECTOR_RADIX_BUCKETS];
+    size_t m_pass;
+};
+
+/*!
+    \struct
+    \brief      State shared by the threads of one vector_foreach_parallel* call
+
+    Chunk 0 is [0, m_head + m_grain); chunk k > 0 is
+    [m_head + k * m_grain, m_head + (k + 1) * m_grain), clipped to m_n.
+    Threads claim chunks in order through m_next,
+    so faster threads simply take more of them.
+*/
+struct cgcs_vector_parallel_foreach {
+    vector_t *m_self;
+    vector_iterator_t m_beg;
+    size_t m_n;
+    size_t m_head;              // blocks before the first cache-line boundary
+    size_t m_grain;
+    size_t m_next;              // next chunk to claim (atomic)
+
+    // Exactly one of these is set.
+    void (*m_func)(void *);
+    void (^m_block)(void *);
+    void (*m_reduce)(void *elem, void *acc);
+
+    char *m_partials;           // one accumulator per thread, m_stride bytes apart
+    size_t m_stride;
+};
+
+/*!
+    \brief      Resolves a requested thread count
+
+    \param[in]  nthreads    0 for as many as the pool has
+                            (one per online CPU, unless set by vector_pool_start)
+
+    \return     nthreads, or vector_pool_nthreads()
+*/
+size_t cgcs_vector_parallel_nthreads(size_t nthreads) {
+    return nthreads > 0 ? nthreads : vector_pool_nthreads();
+}
+
+/*!
+    \brief      Calls fn(arg, i) for every i in [0, nthreads), in parallel,
+                and returns once every call has returned
+
+    Calls 1 to nthreads - 1 are spawned as tasks on the pool
+    (see cgcs_vector_pool.h); the calling thread runs fn(arg, 0),
+    then helps with the rest. Calls may therefore share a thread:
+    fn must not wait for another index to make progress.
+
+    \param[in]  nthreads
+    \param[in]  fn
+    \param[in]  arg
+*/
+void cgcs_vector_parallel_invoke(size_t nthreads,
+                                 void (*fn)(void *arg, size_t index), void *arg) {
+    vector_task_group_t group;
+    vector_task_t *tasks = NULL;
+
+    if (nthreads <= 1) {
+        if (nthreads == 1) {
+            fn(arg, 0);
+        }
+
+        return;
+    }
+
+    tasks = malloc(sizeof *tasks * nthreads);
+    assert(tasks);
+
+    vector_task_group_init(&group);
+
+    for (size_t i = 1; i < nthreads; i++) {
+        vector_task_spawn(&group, &tasks[i], fn, arg, i);
+    }
+
+    fn(arg, 0);
+    vector_task_wait(&group);
+
+    free(tasks);
+}
+
+/*!
+    \brief      Finds how many of the first d blocks of merge(a, b)
+                come from a (the "co-rank" of d)
+
+    Ties are taken from a first, matching the stable merge
+    done by cgcs_vector_parallel_sort_fn_merge.
+
+    \param[in]  a
+    \param[in]  m       length of a
+    \param[in]  b
+    \param[in]  n       length of b
+    \param[in]  d       output position, in [0, m + n]
+    \param[in]  cmpfn
+
+    \return
+*/
+static size_t
+cgcs_vector_parallel_corank(voidptr *a, size_t m, voidptr *b, size_t n, size_t d,
+                            cgcs_vector_cmpfn cmpfn) {
+    size_t lo = d > n ? d - n : 0;
+    size_t hi = d < m ? d : m;
+
+    while (lo < hi) {
+        const size_t i = lo + (hi - lo) / 2;
+        const size_t j = d - i;
+
+        // If b[j - 1] would not have been taken before a[i],
+        // then too much of b is in the prefix -- take more of a.
+        if (j > 0 && i < m && cgcs_vector_less(cmpfn, b + j - 1, a + i) == false) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+
+    return lo;
+}
+
+/*!
+    \brief      Sorts run index of the shared sort state
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_sort_run(void *arg, size_t index) {
+    struct cgcs_vector_parallel_sort *sort = arg;
+    voidptr *first = sort->m_src + sort->m_bounds[index];
+    voidptr *last = sort->m_src + sort->m_bounds[index + 1];
+
+    if (sort->m_stable) {
+        // Each run borrows the part of m_scratch lined up with it.
+        cgcs_vector_parallel_sort_fn_mergesort(first, last,
+                                               sort->m_scratch + sort->m_bounds[index],
+                                               sort->m_cmpfn);
+    } else {
+        cgcs_vector_parallel_sort_fn_pdqsort(first, last, sort->m_cmpfn);
+    }
+}
+
+/*!
+    \brief      Performs every index-th (mod m_nthreads) slice of a merge round
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_sort_merge(void *arg, size_t index) {
+    struct cgcs_vector_parallel_sort *sort = arg;
+
+    for (size_t i = index; i < sort->m_nmerges; i += sort->m_nthreads) {
+        struct cgcs_vector_parallel_merge *merge = &sort->m_merges[i];
+
+        cgcs_vector_parallel_sort_fn_merge(merge->m_a, merge->m_a_last,
+                                           merge->m_b, merge->m_b_last,
+                                           merge->m_out, sort->m_cmpfn);
+    }
+}
+
+/*!
+    \brief      Merges adjacent pairs of runs from m_src into m_scratch,
+                then swaps the two, halving the number of runs
+
+    Each pair is cut into slices of (roughly) equal output length,
+    so that every thread has work even when few pairs remain.
+
+    \param[in]  sort
+*/
+static void
+cgcs_vector_parallel_sort_merge_round(struct cgcs_vector_parallel_sort *sort) {
+    const size_t npairs = sort->m_nruns / 2;
+    const size_t nslices = (sort->m_nthreads + npairs - 1) / npairs;
+    voidptr *tmp = NULL;
+    size_t nruns = 0;
+
+    sort->m_nmerges = 0;
+
+    for (size_t r = 0; r < sort->m_nruns; r += 2) {
+        voidptr *a = sort->m_src + sort->m_bounds[r];
+        voidptr *out = sort->m_scratch + sort->m_bounds[r];
+        const size_t m = sort->m_bounds[r + 1] - sort->m_bounds[r];
+        size_t n = 0;
+        voidptr *b = NULL;
+
+        if (r + 1 == sort->m_nruns) {
+            // An odd run out is carried over to the next round as is.
+            struct cgcs_vector_parallel_merge *merge = &sort->m_merges[sort->m_nmerges++];
+
+            merge->m_a = a;
+            merge->m_a_last = a + m;
+            merge->m_b = merge->m_b_last = a + m;
+            merge->m_out = out;
+        } else {
+            b = sort->m_src + sort->m_bounds[r + 1];
+            n = sort->m_bounds[r + 2] - sort->m_bounds[r + 1];
+
+            for (size_t s = 0; s < nslices; s++) {
+                struct cgcs_vector_parallel_merge *merge = &sort->m_merges[sort->m_nmerges++];
+                const size_t d0 = (m + n) * s / nslices;
+                const size_t d1 = (m + n) * (s + 1) / nslices;
+                const size_t i0 = cgcs_vector_parallel_corank(a, m, b, n, d0, sort->m_cmpfn);
+                const size_t i1 = cgcs_vector_parallel_corank(a, m, b, n, d1, sort->m_cmpfn);
+
+                merge->m_a = a + i0;
+                merge->m_a_last = a + i1;
+                merge->m_b = b + (d0 - i0);
+                merge->m_b_last = b + (d1 - i1);
+                merge->m_out = out + d0;
+            }
+        }
+
+        sort->m_bounds[nruns++] = sort->m_bounds[r];
+    }
+
+    sort->m_bounds[nruns] = sort->m_bounds[sort->m_nruns];
+    cgcs_vector_parallel_invoke(sort->m_nthreads, cgcs_vector_parallel_sort_merge, sort);
+
+    sort->m_nruns = nruns;
+
+    tmp = sort->m_src;
+    sort->m_src = sort->m_scratch;
+    sort->m_scratch = tmp;
+}
+
+/*!
+    \brief      Sorts [pos, end): each thread sorts one run, then runs are
+                merged pairwise, every round split across all threads
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  pos
+    \param[in]  end
+    \param[in]  nthreads
+    \param[in]  stable
+*/
+static void
+cgcs_vector_parallel_sort_impl(vector_t *self, cgcs_vector_cmpfn cmpfn,
+                               vector_iterator_t pos, vector_iterator_t end,
+                               size_t nthreads, bool stable) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    const size_t n = end - pos;
+    struct cgcs_vector_parallel_sort sort;
+    size_t nruns = 0;
+
+    // Slices are merged as voidptr; vectors made with vector_init_elem
+    // are left to the serial sorts, which sort them by address.
+    assert(vector_elem_size(self) == sizeof(voidptr));
+
+    nthreads = cgcs_vector_parallel_nthreads(nthreads);
+    nruns = n / CGCS_VECTOR_PARALLEL_GRAIN;
+    nruns = nruns < nthreads ? nruns : nthreads;
+
+    if (nruns <= 1) {
+        if (stable) {
+            vector_mergesort_range(self, cmpfn, pos, end);
+        } else {
+            vector_qsort_range(self, cmpfn, pos, end);
+        }
+
+        return;
+    }
+
+    sort.m_cmpfn = cmpfn;
+    sort.m_stable = stable;
+    sort.m_src = pos;
+    sort.m_scratch = alloc->m_allocfn(alloc->m_ctx, sizeof(voidptr) * n);
+    sort.m_bounds = malloc(sizeof *sort.m_bounds * (nruns + 1));
+    sort.m_nruns = nruns;
+    sort.m_merges = malloc(sizeof *sort.m_merges * (nruns + 2 * nthreads));
+    sort.m_nmerges = 0;
+    sort.m_nthreads = nthreads;
+    assert(sort.m_scratch && sort.m_bounds && sort.m_merges);
+
+    for (size_t i = 0; i <= nruns; i++) {
+        sort.m_bounds[i] = n * i / nruns;
+    }
+
+    cgcs_vector_parallel_invoke(nruns, cgcs_vector_parallel_sort_run, &sort);
+
+    while (sort.m_nruns > 1) {
+        cgcs_vector_parallel_sort_merge_round(&sort);
+    }
+
+    // An odd number of rounds leaves the result in the scratch buffer.
+    if (sort.m_src != pos) {
+        memcpy(pos, sort.m_src, sizeof(voidptr) * n);
+        sort.m_scratch = sort.m_src;
+    }
+
+    alloc->m_freefn(alloc->m_ctx, sort.m_scratch, sizeof(voidptr) * n);
+    free(sort.m_merges);
+    free(sort.m_bounds);
+
+    vector_index_rebuild(self);
+}
+
+/*!
+    \brief      Extracts the keys of chunk index, and counts all of its digits
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_radix_extract(void *arg, size_t index) {
+    struct cgcs_vector_parallel_radix *radix = arg;
+    struct cgcs_vector_radix_item *items = radix->m_src;
+
+    for (size_t i = radix->m_bounds[index]; i < radix->m_bounds[index + 1]; i++) {
+        items[i].m_key = radix->m_keyfn(radix->m_pos + i);
+        items[i].m_ptr = radix->m_pos[i];
+    }
+
+    memset(radix->m_hist[index], 0, sizeof radix->m_hist[index]);
+    cgcs_vector_radix_histogram(items + radix->m_bounds[index],
+                                items + radix->m_bounds[index + 1], radix->m_hist[index]);
+}
+
+/*!
+    \brief      Recounts the digits of the current pass in chunk index
+                (chunks change contents after every pass)
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_radix_count(void *arg, size_t index) {
+    struct cgcs_vector_parallel_radix *radix = arg;
+    const size_t pass = radix->m_pass;
+    size_t *row = radix->m_hist[index][pass];
+
+    memset(row, 0, sizeof *row * CGCS_VECTOR_RADIX_BUCKETS);
+
+    for (size_t i = radix->m_bounds[index]; i < radix->m_bounds[index + 1]; i++) {
+        ++row[cgcs_vector_radix_digit(radix->m_src[i].m_key, pass)];
+    }
+}
+
+/*!
+    \brief      Scatters chunk index into m_dst, at the offsets left
+                in its row of m_hist
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_radix_scatter(void *arg, size_t index) {
+    struct cgcs_vector_parallel_radix *radix = arg;
+
+    cgcs_vector_radix_scatter(radix->m_src + radix->m_bounds[index],
+                              radix->m_src + radix->m_bounds[index + 1],
+                              radix->m_dst, radix->m_hist[index][radix->m_pass],
+                              radix->m_pass);
+}
+
+/*!
+    \brief      Copies chunk index of the sorted items back into the vector
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_radix_store(void *arg, size_t index) {
+    struct cgcs_vector_parallel_radix *radix = arg;
+
+    for (size_t i = radix->m_bounds[index]; i < radix->m_bounds[index + 1]; i++) {
+        radix->m_pos[i] = radix->m_src[i].m_ptr;
+    }
+}
+
+static inline size_t cgcs_vector_parallel_gcd(size_t a, size_t b) {
+    while (b) {
+        const size_t r = a % b;
+        a = b;
+        b = r;
+    }
+
+    return a;
+}
+
+/*!
+    \brief      Splits [beg, end) into chunks, per opts
+
+    \param[in]  foreach
+    \param[in]  self
+    \param[in]  beg
+    \param[in]  end
+    \param[in]  opts
+
+    \return     the number of threads worth starting (0 if [beg, end) is empty)
+*/
+static size_t
+cgcs_vector_parallel_foreach_plan(struct cgcs_vector_parallel_foreach *foreach, vector_t *self,
+                                  vector_iterator_t beg, vector_iterator_t end,
+                                  const vector_parallel_opts_t *opts) {
+    const size_t line = CGCS_VECTOR_PARALLEL_CACHE_LINE;
+    const size_t n = vector_distance(self, beg, end);
+
+    // A multiple of unit blocks is a whole number of cache lines.
+    const size_t unit = line / cgcs_vector_parallel_gcd(line, vector_elem_size(self));
+
+    size_t nthreads = cgcs_vector_parallel_nthreads(opts ? opts->m_nthreads : 0);
+    size_t grain = opts && opts->m_grain ? opts->m_grain : n / (nthreads * 8);
+    size_t nchunks = 0;
+
+    grain = grain < unit ? unit : (grain + unit - 1) / unit * unit;
+
+    memset(foreach, 0, sizeof *foreach);
+    foreach->m_self = self;
+    foreach->m_beg = beg;
+    foreach->m_n = n;
+    foreach->m_grain = grain;
+
+    for (size_t h = 0; h < unit && h < n; h++) {
+        if ((uintptr_t)vector_advance(self, beg, h) % line == 0) {
+            foreach->m_head = h;
+            break;
+        }
+    }
+
+    if (n > 0) {
+        const size_t first = foreach->m_head + grain;
+        nchunks = 1 + (n > first ? (n - first + grain - 1) / grain : 0);
+    }
+
+    return nthreads < nchunks ? nthreads : nchunks;
+}
+
+/*!
+    \brief      Claims chunks until none are left, applying the function
+                (or block) to each of their blocks
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_parallel_foreach_run(void *arg, size_t index) {
+    struct cgcs_vector_parallel_foreach *foreach = arg;
+    vector_t *self = foreach->m_self;
+    void *acc = foreach->m_partials ? foreach->m_partials + foreach->m_stride * index : NULL;
+
+    for (;;) {
+        const size_t k = __atomic_fetch_add(&foreach->m_next, 1, __ATOMIC_RELAXED);
+        const size_t first = k == 0 ? 0 : foreach->m_head + k * foreach->m_grain;
+        size_t last = foreach->m_head + (k + 1) * foreach->m_grain;
+        vector_iterator_t it = NULL;
+        vector_iterator_t end = NULL;
+
+        if (first >= foreach->m_n) {
+            break;
+        }
+
+        last = last < foreach->m_n ? last : foreach->m_n;
+        it = vector_advance(self, foreach->m_beg, first);
+        end = vector_advance(self, foreach->m_beg, last);
+
+        if (foreach->m_reduce) {
+            for (; it < end; it = vector_advance(self, it, 1)) {
+                foreach->m_reduce(it, acc);
+            }
+        } else if (foreach->m_func) {
+            for (; it < end; it = vector_advance(self, it, 1)) {
+                foreach->m_func(it);
+            }
+        } else {
+            for (; it < end; it = vector_advance(self, it, 1)) {
+                foreach->m_block(it);
+            }
+        }
+    }
+}
+
+/*!
+    \brief      Calls func on every block of self, on a pool of threads
+
+    Blocks are handed out in chunks of opts->m_grain blocks (rounded up
+    to whole cache lines), claimed one at a time by whichever thread is
+    free, so uneven per-block work still balances.
+    func must be safe to call concurrently on different blocks;
+    the order of calls is unspecified.
+
+    \param[in]  self
+    \param[in]  func
+    \param[in]  opts   NULL for the defaults
+*/
+void vector_foreach_parallel(vector_t *self, void (*func)(void *),
+                             const vector_parallel_opts_t *opts) {
+    vector_foreach_parallel_range(self, func, vector_begin(self), vector_end(self), opts);
+}
+
+void vector_foreach_parallel_b(vector_t *self, void (^block)(void *),
+                               const vector_parallel_opts_t *opts) {
+    vector_foreach_parallel_range_b(self, block, vector_begin(self), vector_end(self), opts);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  func
+    \param[in]  beg
+    \param[in]  end
+    \param[in]  opts
+*/
+void vector_foreach_parallel_range(vector_t *self, void (*func)(void *),
+                                   vector_iterator_t beg, vector_iterator_t end,
+                                   const vector_parallel_opts_t *opts) {
+    struct cgcs_vector_parallel_foreach foreach;
+    const size_t nthreads = cgcs_vector_parallel_foreach_plan(&foreach, self, beg, end, opts);
+
+    foreach.m_func = func;
+    cgcs_vector_parallel_invoke(nthreads, cgcs_vector_parallel_foreach_run, &foreach);
+}
+
+void vector_foreach_parallel_range_b(vector_t *self, void (^block)(void *),
+                                     vector_iterator_t beg, vector_iterator_t end,
+                                     const vector_parallel_opts_t *opts) {
+    struct cgcs_vector_parallel_foreach foreach;
+    const size_t nthreads = cgcs_vector_parallel_foreach_plan(&foreach, self, beg, end, opts);
+
+    foreach.m_block = block;
+    cgcs_vector_parallel_invoke(nthreads, cgcs_vector_parallel_foreach_run, &foreach);
+}
+
+/*!
+    \brief      Folds every block of self into *acc, on a pool of threads
+
+    Each thread starts from its own copy of *acc (acc_size bytes),
+    which must therefore hold the identity of the fold (i.e. 0 for a sum),
+    and calls func(block, its_acc) for each block it claims.
+    The per-thread results are then folded into *acc, in thread order,
+    with combine(acc, partial) on the calling thread.
+
+    Since blocks are claimed in any order, the fold must not depend
+    on order (combine must be associative and commutative).
+
+    \param[in]  self
+    \param[in]  func
+    \param[in]  combine
+    \param[in]  acc
+    \param[in]  acc_size
+    \param[in]  opts
+*/
+void vector_foreach_parallel_reduce(vector_t *self,
+                                    void (*func)(void *elem, void *acc),
+                                    void (*combine)(void *acc, const void *partial),
+                                    void *acc, size_t acc_size,
+                                    const vector_parallel_opts_t *opts) {
+    vector_foreach_parallel_reduce_range(self, func, combine, acc, acc_size,
+                                         vector_begin(self), vector_end(self), opts);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  func
+    \param[in]  combine
+    \param[in]  acc
+    \param[in]  acc_size
+    \param[in]  beg
+    \param[in]  end
+    \param[in]  opts
+*/
+void vector_foreach_parallel_reduce_range(vector_t *self,
+                                          void (*func)(void *elem, void *acc),
+                                          void (*combine)(void *acc, const void *partial),
+                                          void *acc, size_t acc_size,
+                                          vector_iterator_t beg, vector_iterator_t end,
+                                          const vector_parallel_opts_t *opts) {
+    const size_t line = CGCS_VECTOR_PARALLEL_CACHE_LINE;
+    struct cgcs_vector_parallel_foreach foreach;
+    const size_t nthreads = cgcs_vector_parallel_foreach_plan(&foreach, self, beg, end, opts);
+
+    assert(acc_size > 0);
+
+    if (nthreads == 0) {
+        return;
+    }
+
+    // Partials are a whole number of cache lines apart,
+    // so threads updating their own never contend.
+    foreach.m_reduce = func;
+    foreach.m_stride = (acc_size + line - 1) / line * line;
+    foreach.m_partials = aligned_alloc(line, foreach.m_stride * nthreads);
+    assert(foreach.m_partials);
+
+    for (size_t t = 0; t < nthreads; t++) {
+        memcpy(foreach.m_partials + foreach.m_stride * t, acc, acc_size);
+    }
+
+    cgcs_vector_parallel_invoke(nthreads, cgcs_vector_parallel_foreach_run, &foreach);
+
+    for (size_t t = 0; t < nthreads; t++) {
+        combine(acc, foreach.m_partials + foreach.m_stride * t);
+    }
+
+    free(foreach.m_partials);
+}
+
+/*!
+    \brief      Sorts self on nthreads threads (unstable)
+
+    Yields the same order as vector_qsort (up to the order of equal blocks).
+    Requires a vector made with vector_init (blocks are pointers).
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  nthreads
+*/
+void vector_parallel_sort(vector_t *self,
+                          int (*cmpfn)(const void *, const void *), size_t nthreads) {
+    vector_parallel_sort_range(self, cmpfn, vector_begin(self), vector_end(self), nthreads);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  pos
+    \param[in]  end
+    \param[in]  nthreads
+*/
+void vector_parallel_sort_range(vector_t *self,
+                                int (*cmpfn)(const void *, const void *),
+                                vector_iterator_t pos, vector_iterator_t end,
+                                size_t nthreads) {
+    cgcs_vector_parallel_sort_impl(self, cmpfn, pos, end, nthreads, false);
+}
+
+/*!
+    \brief      Sorts self on nthreads threads (stable)
+
+    Yields exactly the same order as vector_mergesort.
+    Requires a vector made with vector_init (blocks are pointers).
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  nthreads
+*/
+void vector_parallel_mergesort(vector_t *self,
+                               int (*cmpfn)(const void *, const void *), size_t nthreads) {
+    vector_parallel_mergesort_range(self, cmpfn, vector_begin(self), vector_end(self), nthreads);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  pos
+    \param[in]  end
+    \param[in]  nthreads
+*/
+void vector_parallel_mergesort_range(vector_t *self,
+                                     int (*cmpfn)(const void *, const void *),
+                                     vector_iterator_t pos, vector_iterator_t end,
+                                     size_t nthreads) {
+    cgcs_vector_parallel_sort_impl(self, cmpfn, pos, end, nthreads, true);
+}
+
+/*!
+    \brief      Sorts self by key on nthreads threads (stable)
+
+    Yields exactly the same order as vector_radix_sort_by_key.
+    Requires a vector made with vector_init (blocks are pointers).
+
+    \param[in]  self
+    \param[in]  keyfn
+    \param[in]  nthreads
+*/
+void vector_parallel_radix_sort_by_key(vector_t *self,
+                                       uint64_t (*keyfn)(const void *), size_t nthreads) {
+    vector_parallel_radix_sort_by_key_range(self, keyfn, vector_begin(self), vector_end(self), nthreads);
+}
+
+/*!
+    \brief      Sorts [pos, end) by key: every thread extracts and counts
+                the keys of one chunk, then, for each pass,
+                every thread scatters its own chunk
+
+    Per-chunk counts are turned into offsets bucket by bucket,
+    chunk by chunk, so each chunk writes to its own disjoint slots
+    and the order of equal digits is kept (stable).
+
+    \param[in]  self
+    \param[in]  keyfn
+    \param[in]  pos
+    \param[in]  end
+    \param[in]  nthreads
+*/
+void vector_parallel_radix_sort_by_key_range(vector_t *self,
+                                             uint64_t (*keyfn)(const void *),
+                                             vector_iterator_t pos, vector_iterator_t end,
+                                             size_t nthreads) {
+    const vector_allocator_t *alloc = self->m_impl.m_alloc;
+    const size_t n = end - pos;
+    struct cgcs_vector_parallel_radix radix;
+    struct cgcs_vector_radix_item *items = NULL;
+    size_t nchunks = 0;
+    bool moved = false;
+
+    assert(vector_elem_size(self) == sizeof(voidptr));
+
+    nthreads = cgcs_vector_parallel_nthreads(nthreads);
+    nchunks = n / CGCS_VECTOR_PARALLEL_GRAIN;
+    nchunks = nchunks < nthreads ? nchunks : nthreads;
+
+    if (nchunks <= 1) {
+        vector_radix_sort_by_key_range(self, keyfn, pos, end);
+        return;
+    }
+
+    items = alloc->m_allocfn(alloc->m_ctx, sizeof *items * n * 2);
+
+    radix.m_keyfn = keyfn;
+    radix.m_pos = pos;
+    radix.m_src = items;
+    radix.m_dst = items + n;
+    radix.m_bounds = malloc(sizeof *radix.m_bounds * (nchunks + 1));
+    radix.m_hist = malloc(sizeof *radix.m_hist * nchunks);
+    radix.m_pass = 0;
+    assert(items && radix.m_bounds && radix.m_hist);
+
+    for (size_t t = 0; t <= nchunks; t++) {
+        radix.m_bounds[t] = n * t / nchunks;
+    }
+
+    cgcs_vector_parallel_invoke(nchunks, cgcs_vector_parallel_radix_extract, &radix);
+
+    for (size_t pass = 0; pass < CGCS_VECTOR_RADIX_PASSES; pass++) {
+        struct cgcs_vector_radix_item *tmp = NULL;
+        size_t total[CGCS_VECTOR_RADIX_BUCKETS] = { 0 };
+        size_t sum = 0;
+
+        // The digit totals do not depend on the order of the items,
+        // so the counts made during extraction tell which passes to skip.
+        for (size_t t = 0; t < nchunks; t++) {
+            for (size_t b = 0; b < CGCS_VECTOR_RADIX_BUCKETS; b++) {
+                total[b] += radix.m_hist[t][pass][b];
+            }
+        }
+
+        if (cgcs_vector_radix_trivial(total, n)) {
+            continue;
+        }
+
+        radix.m_pass = pass;
+
+        if (moved) {
+            cgcs_vector_parallel_invoke(nchunks, cgcs_vector_parallel_radix_count, &radix);
+        }
+
+        for (size_t b = 0; b < CGCS_VECTOR_RADIX_BUCKETS; b++) {
+            for (size_t t = 0; t < nchunks; t++) {
+                const size_t count = radix.m_hist[t][pass][b];
+                radix.m_hist[t][pass][b] = sum;
+                sum += count;
+            }
+        }
+
+        cgcs_vector_parallel_invoke(nchunks, cgcs_vector_parallel_radix_scatter, &radix);
+        moved = true;
+
+        tmp = radix.m_src;
+        radix.m_src = radix.m_dst;
+        radix.m_dst = tmp;
+    }
+
+    cgcs_vector_parallel_invoke(nchunks, cgcs_vector_parallel_radix_store, &radix);
+
+    alloc->m_freefn(alloc->m_ctx, items, sizeof *items * n * 2);
+    free(radix.m_hist);
+    free(radix.m_bounds);
+
+    vector_index_rebuild(self);
+}
@@ -0,0 +1,87 @@
+/*!
+    \file       cgcs_vector_parallel.h
+    \brief      Header file for multithreaded algorithms over vector_t
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_PARALLEL_H
+#define CGCS_VECTOR_PARALLEL_H
+
+#include "cgcs_vector.h"
+
+/*
+    For every function below, nthreads == 0 means "as many threads as the
+    pool has" (see cgcs_vector_parallel_nthreads and cgcs_vector_pool.h).
+    Work is run as tasks on the pool, so no thread is created per call.
+    Ranges too short to be worth splitting are handled on the calling thread.
+*/
+
+/*!
+    \struct
+    \brief      Options for the vector_foreach_parallel family;
+                pass NULL for the defaults (all zero)
+*/
+struct cgcs_vector_parallel_opts {
+    size_t m_nthreads;      // 0: as many as the pool has
+    size_t m_grain;         // blocks per chunk; 0: about 8 chunks per thread
+};
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_parallel_opts vector_parallel_opts_t;
+
+size_t cgcs_vector_parallel_nthreads(size_t nthreads);
+
+void cgcs_vector_parallel_invoke(size_t nthreads,
+                                 void (*fn)(void *arg, size_t index), void *arg);
+
+void vector_parallel_sort(vector_t *self,
+                          int (*cmpfn)(const void *, const void *), size_t nthreads);
+void vector_parallel_sort_range(vector_t *self,
+                                int (*cmpfn)(const void *, const void *),
+                                vector_iterator_t pos, vector_iterator_t end,
+                                size_t nthreads);
+
+void vector_parallel_mergesort(vector_t *self,
+                               int (*cmpfn)(const void *, const void *), size_t nthreads);
+void vector_parallel_mergesort_range(vector_t *self,
+                                     int (*cmpfn)(const void *, const void *),
+                                     vector_iterator_t pos, vector_iterator_t end,
+                                     size_t nthreads);
+
+void vector_foreach_parallel(vector_t *self, void (*func)(void *),
+                             const vector_parallel_opts_t *opts);
+void vector_foreach_parallel_b(vector_t *self, void (^block)(void *),
+                               const vector_parallel_opts_t *opts);
+
+void vector_foreach_parallel_range(vector_t *self, void (*func)(void *),
+                                   vector_iterator_t beg, vector_iterator_t end,
+                                   const vector_parallel_opts_t *opts);
+void vector_foreach_parallel_range_b(vector_t *self, void (^block)(void *),
+                                     vector_iterator_t beg, vector_iterator_t end,
+                                     const vector_parallel_opts_t *opts);
+
+void vector_foreach_parallel_reduce(vector_t *self,
+                                    void (*func)(void *elem, void *acc),
+                                    void (*combine)(void *acc, const void *partial),
+                                    void *acc, size_t acc_size,
+                                    const vector_parallel_opts_t *opts);
+void vector_foreach_parallel_reduce_range(vector_t *self,
+                                          void (*func)(void *elem, void *acc),
+                                          void (*combine)(void *acc, const void *partial),
+                                          void *acc, size_t acc_size,
+                                          vector_iterator_t beg, vector_iterator_t end,
+                                          const vector_parallel_opts_t *opts);
+
+void vector_parallel_radix_sort_by_key(vector_t *self,
+                                       uint64_t (*keyfn)(const void *), size_t nthreads);
+void vector_parallel_radix_sort_by_key_range(vector_t *self,
+                                             uint64_t (*keyfn)(const void *),
+                                             vector_iterator_t pos, vector_iterator_t end,
+                                             size_t nthreads);
+
+#endif /* CGCS_VECTOR_PARALLEL_H */
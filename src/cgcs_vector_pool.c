@@ -0,0 +1,576 @@
+/*!
+    \file       cgcs_vector_pool.c
+    \brief      Source file for the work-stealing thread pool
+                behind the vector_*parallel* family
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_pool.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// Slots per worker deque (a power of 2).
+// A worker whose deque is full runs the task it was about to push.
+#define CGCS_VECTOR_POOL_DEQUE_CAPACITY 1024
+
+/*!
+    \struct
+    \brief      Chase-Lev work-stealing deque
+
+    The owner pushes and takes at m_bottom; thieves steal at m_top.
+    The two ends sit on separate cache lines.
+*/
+struct cgcs_vector_pool_deque {
+    _Alignas(64) ptrdiff_t m_top;
+    _Alignas(64) ptrdiff_t m_bottom;
+    struct cgcs_vector_task *m_buf[CGCS_VECTOR_POOL_DEQUE_CAPACITY];
+};
+
+/*!
+    \struct
+    \brief
+*/
+struct cgcs_vector_pool_worker {
+    struct cgcs_vector_pool_deque m_deque;
+    pthread_t m_thread;
+    uint64_t m_rng;             // picks the first victim to steal from
+};
+
+/*!
+    \struct
+    \brief      The library's one pool
+
+    m_lock guards starting and stopping, the shared queue,
+    and putting workers to sleep.
+*/
+struct cgcs_vector_pool {
+    pthread_mutex_t m_lock;
+    pthread_cond_t m_wake;
+
+    struct cgcs_vector_pool_worker *m_workers;
+    size_t m_nworkers;
+    size_t m_nstarted;          // workers whose thread is running
+    bool m_running;             // read without m_lock (atomic)
+    bool m_stop;
+
+    // Tasks spawned from outside the pool.
+    struct cgcs_vector_task *m_head;
+    struct cgcs_vector_task *m_tail;
+    size_t m_nqueued;           // read without m_lock (atomic)
+
+    // Bumped on every spawn; a worker only sleeps if it has not changed
+    // since it last looked for work.
+    unsigned long m_epoch;
+    size_t m_nsleeping;
+};
+
+static struct cgcs_vector_pool cgcs_vector_pool = {
+    .m_lock = PTHREAD_MUTEX_INITIALIZER,
+    .m_wake = PTHREAD_COND_INITIALIZER
+};
+
+// The worker the calling thread is, or NULL outside the pool.
+static _Thread_local struct cgcs_vector_pool_worker *cgcs_vector_pool_self;
+
+/*!
+    \brief      Pushes task at the bottom of deque (owner only)
+
+    \param[in]  deque
+    \param[in]  task
+
+    \return     false if deque is full
+*/
+static bool
+cgcs_vector_pool_deque_push(struct cgcs_vector_pool_deque *deque, struct cgcs_vector_task *task) {
+    const ptrdiff_t b = __atomic_load_n(&deque->m_bottom, __ATOMIC_RELAXED);
+    const ptrdiff_t t = __atomic_load_n(&deque->m_top, __ATOMIC_ACQUIRE);
+
+    if (b - t >= CGCS_VECTOR_POOL_DEQUE_CAPACITY) {
+        return false;
+    }
+
+    // Publishes the task (and everything written to it) to thieves,
+    // which read m_bottom with acquire.
+    __atomic_store_n(&deque->m_buf[b & (CGCS_VECTOR_POOL_DEQUE_CAPACITY - 1)], task, __ATOMIC_RELAXED);
+    __atomic_store_n(&deque->m_bottom, b + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+/*!
+    \brief      Takes the newest task from the bottom of deque (owner only)
+
+    \param[in]  deque
+
+    \return     the task, or NULL if deque is empty
+*/
+static struct cgcs_vector_task *
+cgcs_vector_pool_deque_take(struct cgcs_vector_pool_deque *deque) {
+    const ptrdiff_t b = __atomic_load_n(&deque->m_bottom, __ATOMIC_RELAXED) - 1;
+    struct cgcs_vector_task *task = NULL;
+    ptrdiff_t t = 0;
+
+    __atomic_store_n(&deque->m_bottom, b, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    t = __atomic_load_n(&deque->m_top, __ATOMIC_RELAXED);
+
+    if (t <= b) {
+        task = __atomic_load_n(&deque->m_buf[b & (CGCS_VECTOR_POOL_DEQUE_CAPACITY - 1)],
+                               __ATOMIC_RELAXED);
+
+        if (t == b) {
+            // The last task: race the thieves for it.
+            if (__atomic_compare_exchange_n(&deque->m_top, &t, t + 1, false,
+                                            __ATOMIC_SEQ_CST, __ATOMIC_RELAXED) == false) {
+                task = NULL;
+            }
+
+            __atomic_store_n(&deque->m_bottom, b + 1, __ATOMIC_RELAXED);
+        }
+    } else {
+        __atomic_store_n(&deque->m_bottom, b + 1, __ATOMIC_RELAXED);
+    }
+
+    return task;
+}
+
+/*!
+    \brief      Steals the oldest task from the top of deque (any thread)
+
+    \param[in]  deque
+
+    \return     the task, or NULL if deque is empty or another thread won it
+*/
+static struct cgcs_vector_task *
+cgcs_vector_pool_deque_steal(struct cgcs_vector_pool_deque *deque) {
+    ptrdiff_t t = __atomic_load_n(&deque->m_top, __ATOMIC_ACQUIRE);
+    ptrdiff_t b = 0;
+    struct cgcs_vector_task *task = NULL;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    b = __atomic_load_n(&deque->m_bottom, __ATOMIC_ACQUIRE);
+
+    if (t < b) {
+        task = __atomic_load_n(&deque->m_buf[t & (CGCS_VECTOR_POOL_DEQUE_CAPACITY - 1)],
+                               __ATOMIC_RELAXED);
+
+        if (__atomic_compare_exchange_n(&deque->m_top, &t, t + 1, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_RELAXED) == false) {
+            task = NULL;
+        }
+    }
+
+    return task;
+}
+
+/*!
+    \brief      Wakes one sleeping worker, if any, after a spawn
+
+    See cgcs_vector_pool_main for the other half of this handshake.
+*/
+static void cgcs_vector_pool_notify(void) {
+    struct cgcs_vector_pool *pool = &cgcs_vector_pool;
+
+    __atomic_add_fetch(&pool->m_epoch, 1, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&pool->m_nsleeping, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&pool->m_lock);
+        pthread_cond_signal(&pool->m_wake);
+        pthread_mutex_unlock(&pool->m_lock);
+    }
+}
+
+/*!
+    \brief      Finds a task for self to run: its own newest task,
+                else one from the shared queue, else one stolen
+                from another worker
+
+    \param[in]  self    NULL outside the pool
+
+    \return     the task, or NULL if none was found
+*/
+static struct cgcs_vector_task *
+cgcs_vector_pool_find(struct cgcs_vector_pool_worker *self) {
+    struct cgcs_vector_pool *pool = &cgcs_vector_pool;
+    struct cgcs_vector_task *task = NULL;
+    size_t first = 0;
+
+    if (self && (task = cgcs_vector_pool_deque_take(&self->m_deque))) {
+        return task;
+    }
+
+    if (__atomic_load_n(&pool->m_nqueued, __ATOMIC_ACQUIRE) > 0) {
+        pthread_mutex_lock(&pool->m_lock);
+
+        if ((task = pool->m_head)) {
+            pool->m_head = task->m_next;
+            pool->m_tail = pool->m_head ? pool->m_tail : NULL;
+            __atomic_sub_fetch(&pool->m_nqueued, 1, __ATOMIC_RELEASE);
+        }
+
+        pthread_mutex_unlock(&pool->m_lock);
+
+        if (task) {
+            return task;
+        }
+    }
+
+    if (pool->m_nworkers == 0) {
+        return NULL;
+    }
+
+    if (self) {
+        // xorshift64
+        self->m_rng ^= self->m_rng << 13;
+        self->m_rng ^= self->m_rng >> 7;
+        self->m_rng ^= self->m_rng << 17;
+        first = self->m_rng % pool->m_nworkers;
+    }
+
+    for (size_t i = 0; i < pool->m_nworkers; i++) {
+        struct cgcs_vector_pool_worker *victim = &pool->m_workers[(first + i) % pool->m_nworkers];
+
+        if (victim != self && (task = cgcs_vector_pool_deque_steal(&victim->m_deque))) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+    \brief      Runs task, then marks it finished in its group
+
+    task may be freed by its owner as soon as the group count drops,
+    so it is not touched afterwards.
+
+    \param[in]  task
+*/
+static void cgcs_vector_pool_run(struct cgcs_vector_task *task) {
+    struct cgcs_vector_task_group *group = task->m_group;
+
+    task->m_fn(task->m_arg, task->m_index);
+    __atomic_sub_fetch(&group->m_pending, 1, __ATOMIC_RELEASE);
+}
+
+/*!
+    \brief      Main loop of a worker: run tasks, sleep when there are none
+
+    \param[in]  arg
+
+    \return
+*/
+static void *cgcs_vector_pool_main(void *arg) {
+    struct cgcs_vector_pool *pool = &cgcs_vector_pool;
+    struct cgcs_vector_pool_worker *self = arg;
+
+    cgcs_vector_pool_self = self;
+
+    for (;;) {
+        const unsigned long epoch = __atomic_load_n(&pool->m_epoch, __ATOMIC_SEQ_CST);
+        struct cgcs_vector_task *task = cgcs_vector_pool_find(self);
+
+        if (task) {
+            cgcs_vector_pool_run(task);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->m_lock);
+
+        if (pool->m_stop) {
+            pthread_mutex_unlock(&pool->m_lock);
+            break;
+        }
+
+        // A spawn either bumps m_epoch before it sees m_nsleeping rise
+        // (and the epoch check below fails), or sees it risen and signals.
+        __atomic_add_fetch(&pool->m_nsleeping, 1, __ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&pool->m_epoch, __ATOMIC_SEQ_CST) == epoch) {
+            pthread_cond_wait(&pool->m_wake, &pool->m_lock);
+        }
+
+        __atomic_sub_fetch(&pool->m_nsleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&pool->m_lock);
+    }
+
+    return NULL;
+}
+
+/*!
+    \brief      Starts the pool with nthreads threads running tasks
+                (the waiting caller and nthreads - 1 workers)
+
+    Optional: the pool otherwise starts on first use, with nthreads == 0.
+
+    \param[in]  nthreads    0 for one per online CPU
+
+    \return     false if the pool was already running
+*/
+bool vector_pool_start(size_t nthreads) {
+    struct cgcs_vector_pool *pool = &cgcs_vector_pool;
+    bool started = false;
+
+    pthread_mutex_lock(&pool->m_lock);
+
+    if (pool->m_running == false) {
+        size_t nworkers = 0;
+
+        if (nthreads == 0) {
+            const long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+            nthreads = ncpus > 0 ? (size_t)ncpus : 1;
+        }
+
+        nworkers = nthreads - 1;
+
+        pool->m_workers = nworkers > 0 ? aligned_alloc(64, sizeof *pool->m_workers * nworkers) : NULL;
+        pool->m_stop = false;
+        assert(pool->m_workers || nworkers == 0);
+
+        for (size_t i = 0; i < nworkers; i++) {
+            struct cgcs_vector_pool_worker *worker = &pool->m_workers[i];
+
+            worker->m_deque.m_top = 0;
+            worker->m_deque.m_bottom = 0;
+            worker->m_rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+        }
+
+        // Every deque is ready before the first worker starts.
+        // If a thread cannot be started, its deque simply stays empty.
+        pool->m_nworkers = nworkers;
+        pool->m_nstarted = 0;
+
+        while (pool->m_nstarted < nworkers &&
+               pthread_create(&pool->m_workers[pool->m_nstarted].m_thread, NULL,
+                              cgcs_vector_pool_main, &pool->m_workers[pool->m_nstarted]) == 0) {
+            ++pool->m_nstarted;
+        }
+
+        __atomic_store_n(&pool->m_running, true, __ATOMIC_RELEASE);
+        started = true;
+    }
+
+    pthread_mutex_unlock(&pool->m_lock);
+
+    return started;
+}
+
+/*!
+    \brief      Stops and joins every worker of the pool
+
+    No task may be pending. The pool starts again on next use.
+*/
+void vector_pool_stop(void) {
+    struct cgcs_vector_pool *pool = &cgcs_vector_pool;
+
+    pthread_mutex_lock(&pool->m_lock);
+
+    if (pool->m_running == false) {
+        pthread_mutex_unlock(&pool->m_lock);
+        return;
+    }
+
+    pool->m_stop = true;
+    pthread_cond_broadcast(&pool->m_wake);
+    pthread_mutex_unlock(&pool->m_lock);
+
+    for (size_t i = 0; i < pool->m_nstarted; i++) {
+        pthread_join(pool->m_workers[i].m_thread, NULL);
+    }
+
+    pthread_mutex_lock(&pool->m_lock);
+    free(pool->m_workers);
+    pool->m_workers = NULL;
+    pool->m_nworkers = 0;
+    pool->m_nstarted = 0;
+    __atomic_store_n(&pool->m_running, false, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->m_lock);
+}
+
+static inline void cgcs_vector_pool_ensure(void) {
+    if (__atomic_load_n(&cgcs_vector_pool.m_running, __ATOMIC_ACQUIRE) == false) {
+        vector_pool_start(0);
+    }
+}
+
+/*!
+    \brief      Returns the number of threads that run tasks
+                (workers, plus the waiting caller), starting the pool if need be
+
+    \return
+*/
+size_t vector_pool_nthreads(void) {
+    cgcs_vector_pool_ensure();
+    return cgcs_vector_pool.m_nworkers + 1;
+}
+
+/*!
+    \brief
+
+    \param[in]  group
+*/
+void vector_task_group_init(vector_task_group_t *group) {
+    group->m_pending = 0;
+}
+
+/*!
+    \brief      Schedules fn(arg, index) to run on the pool, as part of group
+
+    The caller provides task's storage (see vector_task_t).
+    With no workers (one CPU), fn runs before vector_task_spawn returns.
+
+    \param[in]  group
+    \param[in]  task
+    \param[in]  fn
+    \param[in]  arg
+    \param[in]  index
+*/
+void vector_task_spawn(vector_task_group_t *group, vector_task_t *task,
+                       void (*fn)(void *arg, size_t index), void *arg, size_t index) {
+    struct cgcs_vector_pool *pool = &cgcs_vector_pool;
+    struct cgcs_vector_pool_worker *self = cgcs_vector_pool_self;
+
+    cgcs_vector_pool_ensure();
+
+    task->m_fn = fn;
+    task->m_arg = arg;
+    task->m_index = index;
+    task->m_group = group;
+    task->m_next = NULL;
+
+    __atomic_add_fetch(&group->m_pending, 1, __ATOMIC_RELAXED);
+
+    if (pool->m_nworkers == 0) {
+        cgcs_vector_pool_run(task);
+        return;
+    }
+
+    if (self) {
+        if (cgcs_vector_pool_deque_push(&self->m_deque, task) == false) {
+            cgcs_vector_pool_run(task);
+            return;
+        }
+    } else {
+        pthread_mutex_lock(&pool->m_lock);
+
+        if (pool->m_tail) {
+            pool->m_tail->m_next = task;
+        } else {
+            pool->m_head = task;
+        }
+
+        pool->m_tail = task;
+        __atomic_add_fetch(&pool->m_nqueued, 1, __ATOMIC_RELEASE);
+
+        pthread_mutex_unlock(&pool->m_lock);
+    }
+
+    cgcs_vector_pool_notify();
+}
+
+/*!
+    \brief      Returns once every task spawned into group has finished
+
+    The caller runs pending tasks (its own, or stolen) while it waits.
+
+    \param[in]  group
+*/
+void vector_task_wait(vector_task_group_t *group) {
+    struct cgcs_vector_pool_worker *self = cgcs_vector_pool_self;
+
+    while (__atomic_load_n(&group->m_pending, __ATOMIC_ACQUIRE) > 0) {
+        struct cgcs_vector_task *task = cgcs_vector_pool_find(self);
+
+        if (task) {
+            cgcs_vector_pool_run(task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+/*!
+    \struct
+    \brief      One (sub)range of a vector_parallel_for call
+*/
+struct cgcs_vector_pool_for {
+    vector_t *m_self;
+    vector_iterator_t m_beg;
+    vector_iterator_t m_end;
+    size_t m_grain;
+    void (*m_fn)(vector_t *self, vector_iterator_t beg, vector_iterator_t end, void *arg);
+    void *m_arg;
+};
+
+/*!
+    \brief      Halves range until it is at most m_grain blocks long,
+                spawning the right halves and running the left ones
+
+    \param[in]  arg
+    \param[in]  index
+*/
+static void cgcs_vector_pool_for_split(void *arg, size_t index) {
+    const struct cgcs_vector_pool_for *range = arg;
+    vector_t *self = range->m_self;
+    const size_t n = vector_distance(self, range->m_beg, range->m_end);
+
+    if (n <= range->m_grain) {
+        range->m_fn(self, range->m_beg, range->m_end, range->m_arg);
+    } else {
+        struct cgcs_vector_pool_for left = *range;
+        struct cgcs_vector_pool_for right = *range;
+        vector_task_group_t group;
+        vector_task_t task;
+
+        left.m_end = right.m_beg = vector_advance(self, range->m_beg, n / 2);
+
+        vector_task_group_init(&group);
+        vector_task_spawn(&group, &task, cgcs_vector_pool_for_split, &right, 0);
+        cgcs_vector_pool_for_split(&left, 0);
+        vector_task_wait(&group);
+    }
+}
+
+/*!
+    \brief      Calls fn on subranges of [beg, end) that together cover it,
+                on the pool
+
+    The range is split in halves, recursively, down to at most grain blocks;
+    idle threads steal the largest halves left, which keeps them busy
+    even when the cost per block varies.
+
+    \param[in]  self
+    \param[in]  beg
+    \param[in]  end
+    \param[in]  grain   0 for about 8 subranges per thread
+    \param[in]  fn
+    \param[in]  arg
+*/
+void vector_parallel_for(vector_t *self, vector_iterator_t beg, vector_iterator_t end,
+                         size_t grain,
+                         void (*fn)(vector_t *self, vector_iterator_t beg,
+                                    vector_iterator_t end, void *arg),
+                         void *arg) {
+    const size_t n = vector_distance(self, beg, end);
+    struct cgcs_vector_pool_for range;
+
+    if (grain == 0) {
+        grain = n / (vector_pool_nthreads() * 8);
+        grain = grain > 0 ? grain : 1;
+    }
+
+    range.m_self = self;
+    range.m_beg = beg;
+    range.m_end = end;
+    range.m_grain = grain;
+    range.m_fn = fn;
+    range.m_arg = arg;
+
+    cgcs_vector_pool_for_split(&range, 0);
+}
@@ -0,0 +1,83 @@
+/*!
+    \file       cgcs_vector_pool.h
+    \brief      Header file for the work-stealing thread pool
+                behind the vector_*parallel* family
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_POOL_H
+#define CGCS_VECTOR_POOL_H
+
+#include "cgcs_vector.h"
+
+/*
+    One pool serves the whole library (and its users).
+    It starts on first use, with one thread per online CPU unless
+    vector_pool_start was called first; the thread that waits on a
+    task group runs tasks too, so the pool starts one thread fewer.
+
+    Every worker owns a Chase-Lev deque: it pushes and pops its own tasks
+    at one end, while idle workers steal from the other. Tasks spawned
+    by threads outside the pool go through a shared queue instead.
+
+    Tasks are fork-join: spawn any number into a group, then wait on it.
+    Waiting runs pending tasks rather than blocking, so tasks may
+    themselves spawn and wait (i.e. to split a range recursively).
+*/
+
+/*!
+    \struct
+    \brief      Counts the tasks of a group that have yet to finish
+*/
+struct cgcs_vector_task_group {
+    size_t m_pending;
+};
+
+/*!
+    \struct
+    \brief      A call of m_fn(m_arg, m_index), owned by the caller
+
+    A task must stay alive (and untouched) from vector_task_spawn
+    until vector_task_wait returns for its group.
+*/
+struct cgcs_vector_task {
+    void (*m_fn)(void *arg, size_t index);
+    void *m_arg;
+    size_t m_index;
+
+    struct cgcs_vector_task_group *m_group;
+    struct cgcs_vector_task *m_next;        // in the shared queue
+};
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_task_group vector_task_group_t;
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_task vector_task_t;
+
+bool vector_pool_start(size_t nthreads);
+void vector_pool_stop(void);
+
+size_t vector_pool_nthreads(void);
+
+void vector_task_group_init(vector_task_group_t *group);
+
+void vector_task_spawn(vector_task_group_t *group, vector_task_t *task,
+                       void (*fn)(void *arg, size_t index), void *arg, size_t index);
+void vector_task_wait(vector_task_group_t *group);
+
+void vector_parallel_for(vector_t *self, vector_iterator_t beg, vector_iterator_t end,
+                         size_t grain,
+                         void (*fn)(vector_t *self, vector_iterator_t beg,
+                                    vector_iterator_t end, void *arg),
+                         void *arg);
+
+#endif /* CGCS_VECTOR_POOL_H */
@@ -0,0 +1,346 @@
+/*!
+    \file       cgcs_vector_rcu.c
+    \brief      Source file for a read-mostly vector that publishes
+                immutable snapshots to lock-free readers (RCU style)
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_rcu.h"
+
+#include <assert.h>
+#include <sched.h>
+
+/*!
+    \struct
+    \brief      One published (or draft) version of the vector
+*/
+struct cgcs_vector_rcu_version {
+    vector_t m_vec;
+    uint64_t m_retired_at;      // epoch at which it stopped being current
+    struct cgcs_vector_rcu_version *m_next;
+};
+
+/*!
+    \brief      Allocates a version holding an empty vector
+                with room for capacity blocks
+
+    \param[in]  self
+    \param[in]  capacity
+
+    \return
+*/
+static struct cgcs_vector_rcu_version *
+cgcs_vector_rcu_version_new(vector_rcu_t *self, size_t capacity) {
+    const vector_allocator_t *alloc = self->m_alloc;
+    struct cgcs_vector_rcu_version *version = alloc->m_allocfn(alloc->m_ctx, sizeof *version);
+    assert(version);
+
+    vector_init_elem_allocator(&(version->m_vec), capacity, self->m_elem_size, alloc);
+    version->m_retired_at = 0;
+    version->m_next = NULL;
+
+    return version;
+}
+
+static void
+cgcs_vector_rcu_version_delete(vector_rcu_t *self, struct cgcs_vector_rcu_version *version) {
+    const vector_allocator_t *alloc = self->m_alloc;
+
+    vector_deinit(&(version->m_vec));
+    alloc->m_freefn(alloc->m_ctx, version, sizeof *version);
+}
+
+/*!
+    \brief      Frees every retired version that no reader can still hold
+
+    A version retired at epoch E may be held by a reader that entered
+    at E or before; readers that entered later loaded m_current after
+    the version was replaced. Called with m_write_lock held.
+
+    \param[in]  self
+*/
+static void cgcs_vector_rcu_reclaim(vector_rcu_t *self) {
+    uint64_t oldest = UINT64_MAX;
+
+    for (struct cgcs_vector_rcu_reader *reader = self->m_readers; reader;
+         reader = reader->m_next) {
+        const uint64_t epoch = __atomic_load_n(&reader->m_epoch, __ATOMIC_SEQ_CST);
+
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    while (self->m_retired && self->m_retired->m_retired_at < oldest) {
+        struct cgcs_vector_rcu_version *version = self->m_retired;
+
+        self->m_retired = version->m_next;
+        cgcs_vector_rcu_version_delete(self, version);
+    }
+
+    if (self->m_retired == NULL) {
+        self->m_retired_tail = NULL;
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_rcu_init(vector_rcu_t *self, size_t capacity) {
+    vector_rcu_init_elem(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_rcu_init_elem(vector_rcu_t *self, size_t capacity, size_t elem_size) {
+    vector_rcu_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  alloc
+*/
+void vector_rcu_init_allocator(vector_rcu_t *self, size_t capacity,
+                               const vector_allocator_t *alloc) {
+    vector_rcu_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief      Initializes self with an empty first version
+
+    Versions, and the vectors in them, are allocated from alloc,
+    which must be safe to call from whichever threads write
+    (cgcs_vector_malloc_allocator is).
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+void vector_rcu_init_elem_allocator(vector_rcu_t *self, size_t capacity, size_t elem_size,
+                                    const vector_allocator_t *alloc) {
+    assert(elem_size > 0);
+    assert(alloc);
+
+    self->m_elem_size = elem_size;
+    self->m_alloc = alloc;
+
+    pthread_mutex_init(&(self->m_write_lock), NULL);
+    self->m_draft = NULL;
+    self->m_retired = NULL;
+    self->m_retired_tail = NULL;
+    self->m_readers = NULL;
+
+    // 0 marks a reader outside of a critical section.
+    self->m_epoch = 1;
+    self->m_current = cgcs_vector_rcu_version_new(self, capacity);
+}
+
+/*!
+    \brief      Frees every version of self
+
+    No reader may be in a critical section, and no write in progress.
+
+    \param[in]  self
+*/
+void vector_rcu_deinit(vector_rcu_t *self) {
+    assert(self->m_draft == NULL);
+
+    while (self->m_retired) {
+        struct cgcs_vector_rcu_version *version = self->m_retired;
+
+        self->m_retired = version->m_next;
+        cgcs_vector_rcu_version_delete(self, version);
+    }
+
+    cgcs_vector_rcu_version_delete(self, self->m_current);
+    self->m_current = NULL;
+    self->m_retired_tail = NULL;
+    self->m_readers = NULL;
+
+    pthread_mutex_destroy(&(self->m_write_lock));
+}
+
+/*!
+    \brief      Adds reader to the readers of self
+
+    Each thread that reads self needs a reader of its own, registered
+    once, that outlives its use (i.e. one per thread, for its lifetime).
+
+    \param[in]  self
+    \param[in]  reader
+*/
+void vector_rcu_reader_register(vector_rcu_t *self, vector_rcu_reader_t *reader) {
+    reader->m_epoch = 0;
+
+    pthread_mutex_lock(&(self->m_write_lock));
+    reader->m_next = self->m_readers;
+    self->m_readers = reader;
+    pthread_mutex_unlock(&(self->m_write_lock));
+}
+
+/*!
+    \brief      Removes reader from the readers of self;
+                reader must be outside of a critical section
+
+    \param[in]  self
+    \param[in]  reader
+*/
+void vector_rcu_reader_unregister(vector_rcu_t *self, vector_rcu_reader_t *reader) {
+    struct cgcs_vector_rcu_reader **link = &(self->m_readers);
+
+    assert(reader->m_epoch == 0);
+
+    pthread_mutex_lock(&(self->m_write_lock));
+
+    while (*link != reader) {
+        assert(*link);
+        link = &((*link)->m_next);
+    }
+
+    *link = reader->m_next;
+    pthread_mutex_unlock(&(self->m_write_lock));
+}
+
+/*!
+    \brief      Enters a read-side critical section, and returns
+                the version of the vector current at that moment
+
+    The returned vector stays valid, and unchanged, until
+    vector_rcu_read_unlock; it must not be modified.
+    Critical sections do not nest.
+
+    \param[in]  self
+    \param[in]  reader  registered by the calling thread
+
+    \return
+*/
+vector_t *vector_rcu_read_lock(vector_rcu_t *self, vector_rcu_reader_t *reader) {
+    const uint64_t epoch = __atomic_load_n(&self->m_epoch, __ATOMIC_SEQ_CST);
+
+    assert(reader->m_epoch == 0);
+
+    // The slot is set before m_current is read, so a writer that
+    // cannot see it yet has already published a newer version.
+    __atomic_store_n(&reader->m_epoch, epoch, __ATOMIC_SEQ_CST);
+    return &(__atomic_load_n(&self->m_current, __ATOMIC_SEQ_CST)->m_vec);
+}
+
+/*!
+    \brief      Leaves the read-side critical section; the vector returned
+                by vector_rcu_read_lock may be freed from then on
+
+    \param[in]  self
+    \param[in]  reader
+*/
+void vector_rcu_read_unlock(vector_rcu_t *self, vector_rcu_reader_t *reader) {
+    __atomic_store_n(&reader->m_epoch, 0, __ATOMIC_RELEASE);
+}
+
+/*!
+    \brief      Starts a write, and returns a private copy
+                of the current version to modify
+
+    Blocks until any other write is committed or aborted.
+    Readers are not blocked, and keep seeing the current version.
+
+    \param[in]  self
+
+    \return
+*/
+vector_t *vector_rcu_write_begin(vector_rcu_t *self) {
+    vector_t *current = NULL;
+
+    pthread_mutex_lock(&(self->m_write_lock));
+
+    current = &(self->m_current->m_vec);
+    self->m_draft = cgcs_vector_rcu_version_new(self, vector_capacity(current));
+
+    vector_set_growth(&(self->m_draft->m_vec), current->m_growth, current->m_growth_increment);
+    vector_set_fill(&(self->m_draft->m_vec), current->m_fill);
+    vector_append_n(&(self->m_draft->m_vec), vector_begin(current), vector_size(current));
+
+    return &(self->m_draft->m_vec);
+}
+
+/*!
+    \brief      Publishes the vector returned by vector_rcu_write_begin
+                as the current version, and ends the write
+
+    Readers entering from now on see the new version. The old version
+    is retired, then freed by this or a later commit once no reader
+    holds it; this call never waits for readers.
+
+    \param[in]  self
+*/
+void vector_rcu_write_commit(vector_rcu_t *self) {
+    struct cgcs_vector_rcu_version *old = NULL;
+
+    assert(self->m_draft);
+
+    old = __atomic_exchange_n(&self->m_current, self->m_draft, __ATOMIC_SEQ_CST);
+    old->m_retired_at = __atomic_fetch_add(&self->m_epoch, 1, __ATOMIC_SEQ_CST);
+    self->m_draft = NULL;
+
+    if (self->m_retired_tail) {
+        self->m_retired_tail->m_next = old;
+    } else {
+        self->m_retired = old;
+    }
+
+    self->m_retired_tail = old;
+
+    cgcs_vector_rcu_reclaim(self);
+    pthread_mutex_unlock(&(self->m_write_lock));
+}
+
+/*!
+    \brief      Discards the vector returned by vector_rcu_write_begin,
+                and ends the write
+
+    \param[in]  self
+*/
+void vector_rcu_write_abort(vector_rcu_t *self) {
+    assert(self->m_draft);
+
+    cgcs_vector_rcu_version_delete(self, self->m_draft);
+    self->m_draft = NULL;
+
+    pthread_mutex_unlock(&(self->m_write_lock));
+}
+
+/*!
+    \brief      Waits until every version retired so far has been freed
+
+    Must not be called from within a read-side critical section,
+    which would wait on itself.
+
+    \param[in]  self
+*/
+void vector_rcu_synchronize(vector_rcu_t *self) {
+    pthread_mutex_lock(&(self->m_write_lock));
+    cgcs_vector_rcu_reclaim(self);
+
+    while (self->m_retired) {
+        pthread_mutex_unlock(&(self->m_write_lock));
+        sched_yield();
+
+        pthread_mutex_lock(&(self->m_write_lock));
+        cgcs_vector_rcu_reclaim(self);
+    }
+
+    pthread_mutex_unlock(&(self->m_write_lock));
+}
@@ -0,0 +1,114 @@
+/*!
+    \file       cgcs_vector_rcu.h
+    \brief      Header file for a read-mostly vector that publishes
+                immutable snapshots to lock-free readers (RCU style)
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_RCU_H
+#define CGCS_VECTOR_RCU_H
+
+#include "cgcs_vector.h"
+
+#include <pthread.h>
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_rcu vector_rcu_t;
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_rcu_reader vector_rcu_reader_t;
+
+/*!
+    \struct
+    \brief      A reader's slot: the epoch it entered its read-side
+                critical section at, or 0 outside of one
+
+    Each reader thread registers its own, and only ever writes to it,
+    so it is padded to a cache line of its own.
+*/
+struct cgcs_vector_rcu_reader {
+    _Alignas(64) uint64_t m_epoch;
+    struct cgcs_vector_rcu_reader *m_next;
+};
+
+/*!
+    \struct
+    \brief      A vector whose readers never lock, for data that is read
+                on every core and written rarely (configuration, routing tables)
+
+    Readers get the current version with vector_rcu_read_lock, which
+    writes only to the reader's own slot and reads two words that change
+    once per write -- so readers do not bounce cache lines between cores.
+    A version is immutable once published: readers may use the whole
+    read-only vector_t API on it (vector_find, vector_bsearch, ...).
+
+    Writers are serialized by m_write_lock. vector_rcu_write_begin hands
+    the writer a copy of the current version to change with the usual
+    vector_t API; vector_rcu_write_commit publishes it with one atomic
+    exchange. The old version is retired, and freed (epoch-based
+    reclamation) once every reader that could still hold it has left
+    its critical section.
+
+    \code
+        // each reader thread, once:
+        vector_rcu_reader_t reader;
+        vector_rcu_reader_register(&routes, &reader);
+
+        // each lookup:
+        vector_t *snapshot = vector_rcu_read_lock(&routes, &reader);
+        vector_iterator_t it = vector_bsearch(snapshot, route_cmp, &key);
+        // ... use *it ...
+        vector_rcu_read_unlock(&routes, &reader);
+
+        // a writer:
+        vector_t *next = vector_rcu_write_begin(&routes);
+        vector_push_back(next, &new_route);
+        vector_qsort(next, route_cmp);
+        vector_rcu_write_commit(&routes);
+    \endcode
+*/
+struct cgcs_vector_rcu {
+    // Read by every reader; written once per commit.
+    _Alignas(64) struct cgcs_vector_rcu_version *m_current;
+    uint64_t m_epoch;
+
+    _Alignas(64) pthread_mutex_t m_write_lock;
+    struct cgcs_vector_rcu_version *m_draft;        // between write_begin and commit
+    struct cgcs_vector_rcu_version *m_retired;      // oldest first
+    struct cgcs_vector_rcu_version *m_retired_tail;
+    struct cgcs_vector_rcu_reader *m_readers;
+
+    size_t m_elem_size;
+    const vector_allocator_t *m_alloc;
+};
+
+void vector_rcu_init(vector_rcu_t *self, size_t capacity);
+void vector_rcu_init_elem(vector_rcu_t *self, size_t capacity, size_t elem_size);
+void vector_rcu_init_allocator(vector_rcu_t *self, size_t capacity,
+                               const vector_allocator_t *alloc);
+void vector_rcu_init_elem_allocator(vector_rcu_t *self, size_t capacity, size_t elem_size,
+                                    const vector_allocator_t *alloc);
+
+void vector_rcu_deinit(vector_rcu_t *self);
+
+void vector_rcu_reader_register(vector_rcu_t *self, vector_rcu_reader_t *reader);
+void vector_rcu_reader_unregister(vector_rcu_t *self, vector_rcu_reader_t *reader);
+
+vector_t *vector_rcu_read_lock(vector_rcu_t *self, vector_rcu_reader_t *reader);
+void vector_rcu_read_unlock(vector_rcu_t *self, vector_rcu_reader_t *reader);
+
+vector_t *vector_rcu_write_begin(vector_rcu_t *self);
+void vector_rcu_write_commit(vector_rcu_t *self);
+void vector_rcu_write_abort(vector_rcu_t *self);
+
+void vector_rcu_synchronize(vector_rcu_t *self);
+
+#endif /* CGCS_VECTOR_RCU_H */
@@ -0,0 +1,507 @@
+/*!
+    \file       cgcs_vector_ring.c
+    \brief      Source file for ring buffers (double-ended and
+                single-producer/single-consumer) on vector_t storage
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_ring.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*!
+    \brief      Returns the smallest power of 2 that is at least capacity (and 1)
+
+    \param[in]  capacity
+
+    \return
+*/
+static inline size_t cgcs_vector_ring_round(size_t capacity) {
+    size_t rounded = 1;
+
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+
+    return rounded;
+}
+
+/*!
+    \brief      Gives base a new buffer of capacity blocks
+
+    \param[in]  base
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+static void
+cgcs_vector_ring_new_block(struct cgcs_vector_base *base, size_t capacity, size_t elem_size,
+                           const vector_allocator_t *alloc) {
+    base->m_elem_size = elem_size;
+    base->m_alloc = alloc;
+    base->m_inline = NULL;
+
+    base->m_start = alloc->m_allocfn(alloc->m_ctx, elem_size * capacity);
+    assert(base->m_start);
+
+    base->m_finish = base->m_start;
+    base->m_end_of_storage = (voidptr *)((char *)base->m_start + elem_size * capacity);
+}
+
+static void
+cgcs_vector_ring_delete_block(struct cgcs_vector_base *base) {
+    const vector_allocator_t *alloc = base->m_alloc;
+
+    alloc->m_freefn(alloc->m_ctx, base->m_start,
+                    (char *)base->m_end_of_storage - (char *)base->m_start);
+
+    base->m_start = NULL;
+    base->m_finish = NULL;
+    base->m_end_of_storage = NULL;
+}
+
+/*!
+    \brief      Returns the address of slot in base's buffer
+
+    \param[in]  base
+    \param[in]  slot
+
+    \return
+*/
+static inline char *
+cgcs_vector_ring_slot(struct cgcs_vector_base *base, size_t slot) {
+    return (char *)base->m_start + slot * base->m_elem_size;
+}
+
+/*!
+    \brief      Copies one block from valaddr into dst
+
+    \param[in]  base
+    \param[in]  dst
+    \param[in]  valaddr
+*/
+static inline void
+cgcs_vector_ring_assign(struct cgcs_vector_base *base, void *dst, const void *valaddr) {
+    if (base->m_elem_size == sizeof(voidptr)) {
+        *(voidptr *)(dst) = *(void **)(valaddr);
+    } else {
+        memcpy(dst, valaddr, base->m_elem_size);
+    }
+}
+
+/*!
+    \brief      Doubles the capacity of self, keeping its blocks in order
+
+    The buffer is resized (in place, if the allocator can); then
+    whichever part of the blocks wrapped around -- the front run
+    [m_head, old capacity) or the back run [0, wrapped) -- is shorter
+    moves, so that the blocks are contiguous modulo the new capacity.
+
+    \param[in]  self
+*/
+static void cgcs_vector_ring_grow(vector_ring_t *self) {
+    struct cgcs_vector_base *base = &(self->m_impl);
+    const vector_allocator_t *alloc = base->m_alloc;
+    const size_t elem_size = base->m_elem_size;
+    const size_t capacity = self->m_mask + 1;
+    const size_t front_run = capacity - self->m_head;
+    char *start = NULL;
+
+    if (alloc->m_reallocfn) {
+        start = alloc->m_reallocfn(alloc->m_ctx, base->m_start,
+                                   elem_size * capacity, elem_size * capacity * 2);
+        assert(start);
+    } else {
+        start = alloc->m_allocfn(alloc->m_ctx, elem_size * capacity * 2);
+        assert(start);
+        memcpy(start, base->m_start, elem_size * capacity);
+        alloc->m_freefn(alloc->m_ctx, base->m_start, elem_size * capacity);
+    }
+
+    base->m_start = (voidptr *)start;
+    base->m_finish = base->m_start;
+    base->m_end_of_storage = (voidptr *)(start + elem_size * capacity * 2);
+
+    if (self->m_size > front_run) {
+        const size_t wrapped = self->m_size - front_run;
+
+        if (wrapped <= front_run) {
+            memcpy(start + elem_size * capacity, start, elem_size * wrapped);
+        } else {
+            memcpy(start + elem_size * (capacity + self->m_head),
+                   start + elem_size * self->m_head, elem_size * front_run);
+            self->m_head += capacity;
+        }
+    }
+
+    self->m_mask = capacity * 2 - 1;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_ring_init(vector_ring_t *self, size_t capacity) {
+    vector_ring_init_elem(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_ring_init_elem(vector_ring_t *self, size_t capacity, size_t elem_size) {
+    vector_ring_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  alloc
+*/
+void vector_ring_init_allocator(vector_ring_t *self, size_t capacity,
+                                const vector_allocator_t *alloc) {
+    vector_ring_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief      Initializes an empty ring of elem_size-byte blocks
+
+    capacity is rounded up to a power of 2.
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+void vector_ring_init_elem_allocator(vector_ring_t *self, size_t capacity, size_t elem_size,
+                                     const vector_allocator_t *alloc) {
+    assert(elem_size > 0);
+    assert(alloc);
+
+    capacity = cgcs_vector_ring_round(capacity);
+    cgcs_vector_ring_new_block(&(self->m_impl), capacity, elem_size, alloc);
+
+    self->m_mask = capacity - 1;
+    self->m_head = 0;
+    self->m_size = 0;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_ring_deinit(vector_ring_t *self) {
+    cgcs_vector_ring_delete_block(&(self->m_impl));
+    self->m_size = 0;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  valaddr
+*/
+void vector_ring_push_back(vector_ring_t *self, const void *valaddr) {
+    if (self->m_size > self->m_mask) {
+        cgcs_vector_ring_grow(self);
+    }
+
+    cgcs_vector_ring_assign(&(self->m_impl), vector_ring_at(self, self->m_size), valaddr);
+    ++self->m_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  valaddr
+*/
+void vector_ring_push_front(vector_ring_t *self, const void *valaddr) {
+    if (self->m_size > self->m_mask) {
+        cgcs_vector_ring_grow(self);
+    }
+
+    self->m_head = (self->m_head - 1) & self->m_mask;
+    cgcs_vector_ring_assign(&(self->m_impl), vector_ring_at(self, 0), valaddr);
+    ++self->m_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_ring_pop_back(vector_ring_t *self) {
+    assert(self->m_size > 0);
+    --self->m_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_ring_pop_front(vector_ring_t *self) {
+    assert(self->m_size > 0);
+
+    self->m_head = (self->m_head + 1) & self->m_mask;
+    --self->m_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_ring_clear(vector_ring_t *self) {
+    self->m_head = 0;
+    self->m_size = 0;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_spsc_init(vector_spsc_t *self, size_t capacity) {
+    vector_spsc_init_elem(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_spsc_init_elem(vector_spsc_t *self, size_t capacity, size_t elem_size) {
+    vector_spsc_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  alloc
+*/
+void vector_spsc_init_allocator(vector_spsc_t *self, size_t capacity,
+                                const vector_allocator_t *alloc) {
+    vector_spsc_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief      Initializes an empty queue of elem_size-byte blocks
+
+    capacity is rounded up to a power of 2, and never changes:
+    vector_spsc_push fails while the queue is full.
+    Both threads must be started after this call (or be handed
+    self through something that synchronizes, such as a mutex).
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+void vector_spsc_init_elem_allocator(vector_spsc_t *self, size_t capacity, size_t elem_size,
+                                     const vector_allocator_t *alloc) {
+    assert(elem_size > 0);
+    assert(alloc);
+
+    capacity = cgcs_vector_ring_round(capacity);
+    cgcs_vector_ring_new_block(&(self->m_impl), capacity, elem_size, alloc);
+
+    self->m_mask = capacity - 1;
+    self->m_head = 0;
+    self->m_tail_cache = 0;
+    self->m_tail = 0;
+    self->m_head_cache = 0;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_spsc_deinit(vector_spsc_t *self) {
+    cgcs_vector_ring_delete_block(&(self->m_impl));
+}
+
+/*!
+    \brief      Copies the n blocks at src into slots [first, first + n),
+                wrapping around the end of the buffer
+
+    \param[in]  self
+    \param[in]  first
+    \param[in]  src
+    \param[in]  n
+*/
+static void
+cgcs_vector_spsc_write(vector_spsc_t *self, size_t first, const void *src, size_t n) {
+    const size_t elem_size = self->m_impl.m_elem_size;
+    const size_t slot = first & self->m_mask;
+    const size_t run = n < self->m_mask + 1 - slot ? n : self->m_mask + 1 - slot;
+
+    memcpy(cgcs_vector_ring_slot(&(self->m_impl), slot), src, elem_size * run);
+    memcpy(self->m_impl.m_start, (const char *)src + elem_size * run, elem_size * (n - run));
+}
+
+/*!
+    \brief      Copies the blocks in slots [first, first + n) to dst,
+                wrapping around the end of the buffer
+
+    \param[in]  self
+    \param[in]  first
+    \param[in]  dst
+    \param[in]  n
+*/
+static void
+cgcs_vector_spsc_read(vector_spsc_t *self, size_t first, void *dst, size_t n) {
+    const size_t elem_size = self->m_impl.m_elem_size;
+    const size_t slot = first & self->m_mask;
+    const size_t run = n < self->m_mask + 1 - slot ? n : self->m_mask + 1 - slot;
+
+    memcpy(dst, cgcs_vector_ring_slot(&(self->m_impl), slot), elem_size * run);
+    memcpy((char *)dst + elem_size * run, self->m_impl.m_start, elem_size * (n - run));
+}
+
+/*!
+    \brief      Enqueues a copy of the block at valaddr (producer only)
+
+    \param[in]  self
+    \param[in]  valaddr
+
+    \return     false if the queue is full
+*/
+bool vector_spsc_push(vector_spsc_t *self, const void *valaddr) {
+    const size_t tail = self->m_tail;
+
+    if (tail - self->m_head_cache > self->m_mask) {
+        self->m_head_cache = __atomic_load_n(&self->m_head, __ATOMIC_ACQUIRE);
+
+        if (tail - self->m_head_cache > self->m_mask) {
+            return false;
+        }
+    }
+
+    cgcs_vector_ring_assign(&(self->m_impl),
+                            cgcs_vector_ring_slot(&(self->m_impl), tail & self->m_mask), valaddr);
+
+    // Publishes the block to the consumer.
+    __atomic_store_n(&self->m_tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/*!
+    \brief      Dequeues the oldest block into dst (consumer only)
+
+    dst receives the block itself: in a queue made with
+    vector_spsc_init, that is the pointer that was pushed.
+
+    \param[in]  self
+    \param[out] dst
+
+    \return     false if the queue is empty
+*/
+bool vector_spsc_pop(vector_spsc_t *self, void *dst) {
+    const size_t head = self->m_head;
+
+    if (head == self->m_tail_cache) {
+        self->m_tail_cache = __atomic_load_n(&self->m_tail, __ATOMIC_ACQUIRE);
+
+        if (head == self->m_tail_cache) {
+            return false;
+        }
+    }
+
+    cgcs_vector_ring_assign(&(self->m_impl), dst,
+                            cgcs_vector_ring_slot(&(self->m_impl), head & self->m_mask));
+
+    // Hands the slot back to the producer.
+    __atomic_store_n(&self->m_head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+/*!
+    \brief      Enqueues copies of as many of the n blocks at src
+                as there is room for (producer only)
+
+    \param[in]  self
+    \param[in]  src
+    \param[in]  n
+
+    \return     number of blocks enqueued
+*/
+size_t vector_spsc_push_n(vector_spsc_t *self, const void *src, size_t n) {
+    const size_t tail = self->m_tail;
+    size_t room = self->m_mask + 1 - (tail - self->m_head_cache);
+
+    if (room < n) {
+        self->m_head_cache = __atomic_load_n(&self->m_head, __ATOMIC_ACQUIRE);
+        room = self->m_mask + 1 - (tail - self->m_head_cache);
+        n = n < room ? n : room;
+    }
+
+    if (n > 0) {
+        cgcs_vector_spsc_write(self, tail, src, n);
+        __atomic_store_n(&self->m_tail, tail + n, __ATOMIC_RELEASE);
+    }
+
+    return n;
+}
+
+/*!
+    \brief      Dequeues up to n of the oldest blocks into dst (consumer only)
+
+    \param[in]  self
+    \param[out] dst
+    \param[in]  n
+
+    \return     number of blocks dequeued
+*/
+size_t vector_spsc_pop_n(vector_spsc_t *self, void *dst, size_t n) {
+    const size_t head = self->m_head;
+    size_t ready = self->m_tail_cache - head;
+
+    if (ready < n) {
+        self->m_tail_cache = __atomic_load_n(&self->m_tail, __ATOMIC_ACQUIRE);
+        ready = self->m_tail_cache - head;
+        n = n < ready ? n : ready;
+    }
+
+    if (n > 0) {
+        cgcs_vector_spsc_read(self, head, dst, n);
+        __atomic_store_n(&self->m_head, head + n, __ATOMIC_RELEASE);
+    }
+
+    return n;
+}
+
+/*!
+    \brief      Returns the number of blocks in the queue
+
+    Exact only on a quiescent queue; from either end, it is a snapshot
+    that the other thread may have changed already.
+
+    \param[in]  self
+
+    \return
+*/
+size_t vector_spsc_size(vector_spsc_t *self) {
+    const size_t head = __atomic_load_n(&self->m_head, __ATOMIC_ACQUIRE);
+    const size_t tail = __atomic_load_n(&self->m_tail, __ATOMIC_ACQUIRE);
+
+    return tail - head;
+}
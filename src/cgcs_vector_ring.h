@@ -0,0 +1,196 @@
+/*!
+    \file       cgcs_vector_ring.h
+    \brief      Header file for ring buffers (double-ended and
+                single-producer/single-consumer) on vector_t storage
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_RING_H
+#define CGCS_VECTOR_RING_H
+
+#include "cgcs_vector.h"
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_ring vector_ring_t;
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_spsc vector_spsc_t;
+
+/*!
+    \struct
+    \brief      A growable ring buffer: O(1) push and pop at both ends
+
+    The blocks live in a struct cgcs_vector_base, as a vector_t's do
+    (same allocators, same element sizes), but wrap around the end of
+    the buffer: block i is at slot (m_head + i) & m_mask. Capacity is a
+    power of 2, and m_impl.m_finish is unused.
+
+    Unlike vector_erase(&v, vector_begin(&v)), which moves every block,
+    vector_ring_pop_front moves none.
+*/
+struct cgcs_vector_ring {
+    struct cgcs_vector_base m_impl;
+    size_t m_mask;              // capacity - 1
+    size_t m_head;
+    size_t m_size;
+};
+
+/*!
+    \struct
+    \brief      A fixed-capacity ring buffer for exactly one producer
+                thread and one consumer thread
+
+    Pushing and popping are wait-free: each side writes its own counter
+    (with release) and reads the other's (with acquire), and nothing else.
+    The counters sit on separate cache lines, each next to the owner's
+    cached copy of the other counter, which it only re-reads when the
+    ring looks full (or empty) -- so the two threads rarely touch
+    the same line.
+
+    m_head and m_tail count every block ever popped and pushed;
+    block n lives in slot n & m_mask.
+*/
+struct cgcs_vector_spsc {
+    struct cgcs_vector_base m_impl;
+    size_t m_mask;              // capacity - 1
+
+    // Consumer's line.
+    _Alignas(64) size_t m_head;
+    size_t m_tail_cache;
+
+    // Producer's line.
+    _Alignas(64) size_t m_tail;
+    size_t m_head_cache;
+};
+
+void vector_ring_init(vector_ring_t *self, size_t capacity);
+void vector_ring_init_elem(vector_ring_t *self, size_t capacity, size_t elem_size);
+void vector_ring_init_allocator(vector_ring_t *self, size_t capacity,
+                                const vector_allocator_t *alloc);
+void vector_ring_init_elem_allocator(vector_ring_t *self, size_t capacity, size_t elem_size,
+                                     const vector_allocator_t *alloc);
+
+void vector_ring_deinit(vector_ring_t *self);
+
+void vector_ring_push_back(vector_ring_t *self, const void *valaddr);
+void vector_ring_push_front(vector_ring_t *self, const void *valaddr);
+
+void vector_ring_pop_back(vector_ring_t *self);
+void vector_ring_pop_front(vector_ring_t *self);
+
+void vector_ring_clear(vector_ring_t *self);
+
+static voidptr vector_ring_at(vector_ring_t *self, size_t index);
+static voidptr vector_ring_front(vector_ring_t *self);
+static voidptr vector_ring_back(vector_ring_t *self);
+
+static size_t vector_ring_size(vector_ring_t *self);
+static size_t vector_ring_capacity(vector_ring_t *self);
+static bool vector_ring_empty(vector_ring_t *self);
+
+void vector_spsc_init(vector_spsc_t *self, size_t capacity);
+void vector_spsc_init_elem(vector_spsc_t *self, size_t capacity, size_t elem_size);
+void vector_spsc_init_allocator(vector_spsc_t *self, size_t capacity,
+                                const vector_allocator_t *alloc);
+void vector_spsc_init_elem_allocator(vector_spsc_t *self, size_t capacity, size_t elem_size,
+                                     const vector_allocator_t *alloc);
+
+void vector_spsc_deinit(vector_spsc_t *self);
+
+bool vector_spsc_push(vector_spsc_t *self, const void *valaddr);
+bool vector_spsc_pop(vector_spsc_t *self, void *dst);
+
+size_t vector_spsc_push_n(vector_spsc_t *self, const void *src, size_t n);
+size_t vector_spsc_pop_n(vector_spsc_t *self, void *dst, size_t n);
+
+size_t vector_spsc_size(vector_spsc_t *self);
+static size_t vector_spsc_capacity(vector_spsc_t *self);
+
+/*!
+    \brief      Returns the address of block index, counting from the front
+
+    \param[in]  self
+    \param[in]  index
+
+    \return
+*/
+static inline voidptr vector_ring_at(vector_ring_t *self, size_t index) {
+    const size_t slot = (self->m_head + index) & self->m_mask;
+    return (char *)self->m_impl.m_start + slot * self->m_impl.m_elem_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline voidptr vector_ring_front(vector_ring_t *self) {
+    return vector_ring_at(self, 0);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline voidptr vector_ring_back(vector_ring_t *self) {
+    return vector_ring_at(self, self->m_size - 1);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_ring_size(vector_ring_t *self) {
+    return self->m_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_ring_capacity(vector_ring_t *self) {
+    return self->m_mask + 1;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline bool vector_ring_empty(vector_ring_t *self) {
+    return self->m_size == 0;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_spsc_capacity(vector_spsc_t *self) {
+    return self->m_mask + 1;
+}
+
+#endif /* CGCS_VECTOR_RING_H */
@@ -0,0 +1,537 @@
+/*!
+    \file       cgcs_vector_segmented.c
+    \brief      Source file for a segmented vector, whose blocks never move
+                as it grows
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector_segmented.h"
+#include "cgcs_vector_sort.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*!
+    \struct
+    \brief      The comparator of a sort: a function, or else a block
+*/
+struct cgcs_vector_segmented_cmp {
+    int (*m_fn)(const void *, const void *);
+    int (^m_b)(const void *, const void *);
+};
+
+typedef const struct cgcs_vector_segmented_cmp *cgcs_vector_segmented_cmp_t;
+
+static inline int
+cgcs_vector_segmented_compare(cgcs_vector_segmented_cmp_t cmp, const void *a, const void *b) {
+    return cmp->m_fn ? cmp->m_fn(a, b) : cmp->m_b(a, b);
+}
+
+// Blocks are compared by address, as in vector_qsort; the indirect variant
+// sorts the addresses of the blocks of a segment made with vector_segmented_init_elem.
+#define cgcs_vector_segmented_less(cmp, a, b) (cgcs_vector_segmented_compare((cmp), (a), (b)) < 0)
+#define cgcs_vector_segmented_less_indirect(cmp, a, b)                         \
+    (cgcs_vector_segmented_compare((cmp), *(a), *(b)) < 0)
+
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_segmented_sort, voidptr, cgcs_vector_segmented_cmp_t,
+                        cgcs_vector_segmented_less)
+CGCS_VECTOR_SORT_DEFINE(cgcs_vector_segmented_sort_indirect, voidptr, cgcs_vector_segmented_cmp_t,
+                        cgcs_vector_segmented_less_indirect)
+
+/*!
+    \brief      Returns the number of blocks of segment k in use
+
+    \param[in]  self
+    \param[in]  k
+
+    \return
+*/
+static inline size_t
+cgcs_vector_segmented_seg_size(vector_segmented_t *self, size_t k) {
+    const size_t first = vector_segmented_seg_first(self, k);
+    const size_t capacity = vector_segmented_seg_capacity(self, k);
+
+    if (self->m_size <= first) {
+        return 0;
+    }
+
+    return self->m_size - first < capacity ? self->m_size - first : capacity;
+}
+
+/*!
+    \brief      Copies one block from valaddr into dst
+
+    \param[in]  self
+    \param[in]  dst
+    \param[in]  valaddr
+*/
+static inline void
+cgcs_vector_segmented_assign(vector_segmented_t *self, void *dst, const void *valaddr) {
+    if (self->m_elem_size == sizeof(voidptr)) {
+        *(voidptr *)(dst) = *(void **)(valaddr);
+    } else {
+        memcpy(dst, valaddr, self->m_elem_size);
+    }
+}
+
+/*!
+    \brief      Allocates the next segment
+
+    \param[in]  self
+*/
+static void cgcs_vector_segmented_add_seg(vector_segmented_t *self) {
+    const vector_allocator_t *alloc = self->m_alloc;
+    const size_t k = self->m_nsegs;
+
+    assert(k < CGCS_VECTOR_SEGMENTED_SEGMENTS);
+
+    self->m_segs[k] = alloc->m_allocfn(alloc->m_ctx,
+                                       self->m_elem_size * vector_segmented_seg_capacity(self, k));
+    assert(self->m_segs[k]);
+
+    ++self->m_nsegs;
+}
+
+/*!
+    \brief      Frees segments [nsegs, m_nsegs)
+
+    \param[in]  self
+    \param[in]  nsegs
+*/
+static void cgcs_vector_segmented_truncate(vector_segmented_t *self, size_t nsegs) {
+    const vector_allocator_t *alloc = self->m_alloc;
+
+    while (self->m_nsegs > nsegs) {
+        const size_t k = --self->m_nsegs;
+
+        alloc->m_freefn(alloc->m_ctx, self->m_segs[k],
+                        self->m_elem_size * vector_segmented_seg_capacity(self, k));
+        self->m_segs[k] = NULL;
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+*/
+void vector_segmented_init(vector_segmented_t *self, size_t capacity) {
+    vector_segmented_init_elem(self, capacity, sizeof(voidptr));
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+*/
+void vector_segmented_init_elem(vector_segmented_t *self, size_t capacity, size_t elem_size) {
+    vector_segmented_init_elem_allocator(self, capacity, elem_size, &cgcs_vector_malloc_allocator);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  alloc
+*/
+void vector_segmented_init_allocator(vector_segmented_t *self, size_t capacity,
+                                     const vector_allocator_t *alloc) {
+    vector_segmented_init_elem_allocator(self, capacity, sizeof(voidptr), alloc);
+}
+
+/*!
+    \brief      Initializes an empty vector whose first segment
+                holds capacity blocks of elem_size bytes
+
+    capacity is rounded up to a power of 2. Each later segment is twice
+    the size of the one before it, so the vector doubles its capacity
+    on growth like a vector_t does -- without moving a block.
+
+    \param[in]  self
+    \param[in]  capacity
+    \param[in]  elem_size
+    \param[in]  alloc
+*/
+void vector_segmented_init_elem_allocator(vector_segmented_t *self, size_t capacity,
+                                          size_t elem_size, const vector_allocator_t *alloc) {
+    assert(elem_size > 0);
+    assert(alloc);
+
+    self->m_nsegs = 0;
+    self->m_size = 0;
+    self->m_shift = 0;
+    self->m_elem_size = elem_size;
+    self->m_alloc = alloc;
+
+    while (((size_t)1 << self->m_shift) < capacity) {
+        ++self->m_shift;
+    }
+
+    for (size_t k = 0; k < CGCS_VECTOR_SEGMENTED_SEGMENTS; k++) {
+        self->m_segs[k] = NULL;
+    }
+
+    cgcs_vector_segmented_add_seg(self);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_segmented_deinit(vector_segmented_t *self) {
+    cgcs_vector_segmented_truncate(self, 0);
+    self->m_size = 0;
+}
+
+/*!
+    \brief      Appends a copy of the block at valaddr
+
+    \param[in]  self
+    \param[in]  valaddr
+
+    \return     address of the new block, valid until it is removed
+*/
+voidptr vector_segmented_push_back(vector_segmented_t *self, const void *valaddr) {
+    voidptr dst = NULL;
+
+    if (self->m_size == vector_segmented_capacity(self)) {
+        cgcs_vector_segmented_add_seg(self);
+    }
+
+    dst = vector_segmented_at(self, self->m_size);
+    cgcs_vector_segmented_assign(self, dst, valaddr);
+    ++self->m_size;
+
+    return dst;
+}
+
+/*!
+    \brief      Appends copies of the n blocks at src,
+                one memcpy per segment they land in
+
+    \param[in]  self
+    \param[in]  src
+    \param[in]  n
+*/
+void vector_segmented_append_n(vector_segmented_t *self, const void *src, size_t n) {
+    const char *from = src;
+
+    while (n > 0) {
+        size_t k = 0;
+        size_t room = 0;
+        size_t count = 0;
+
+        if (self->m_size == vector_segmented_capacity(self)) {
+            cgcs_vector_segmented_add_seg(self);
+        }
+
+        k = vector_segmented_seg_of(self, self->m_size);
+        room = vector_segmented_seg_first(self, k + 1) - self->m_size;
+        count = n < room ? n : room;
+
+        memcpy(vector_segmented_at(self, self->m_size), from, self->m_elem_size * count);
+
+        self->m_size += count;
+        from += self->m_elem_size * count;
+        n -= count;
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+*/
+void vector_segmented_pop_back(vector_segmented_t *self) {
+    assert(self->m_size > 0);
+    --self->m_size;
+}
+
+/*!
+    \brief      Removes every block, keeping every segment
+
+    \param[in]  self
+*/
+void vector_segmented_clear(vector_segmented_t *self) {
+    self->m_size = 0;
+}
+
+/*!
+    \brief      Frees the segments that hold no blocks (but never segment 0)
+
+    \param[in]  self
+*/
+void vector_segmented_shrink_to_fit(vector_segmented_t *self) {
+    cgcs_vector_segmented_truncate(self, self->m_size == 0 ? 1
+                                   : vector_segmented_seg_of(self, self->m_size - 1) + 1);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  func
+*/
+void vector_segmented_foreach(vector_segmented_t *self, void (*func)(void *)) {
+    for (size_t k = 0; k < self->m_nsegs; k++) {
+        char *it = (char *)self->m_segs[k];
+        char *const end = it + self->m_elem_size * cgcs_vector_segmented_seg_size(self, k);
+
+        for (; it < end; it += self->m_elem_size) {
+            func(it);
+        }
+    }
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  block
+*/
+void vector_segmented_foreach_b(vector_segmented_t *self, void (^block)(void *)) {
+    for (size_t k = 0; k < self->m_nsegs; k++) {
+        char *it = (char *)self->m_segs[k];
+        char *const end = it + self->m_elem_size * cgcs_vector_segmented_seg_size(self, k);
+
+        for (; it < end; it += self->m_elem_size) {
+            block(it);
+        }
+    }
+}
+
+/*!
+    \brief      Finds the first block for which cmp(block, valaddr) == 0
+
+    \param[in]  self
+    \param[in]  cmp
+    \param[in]  valaddr
+
+    \return
+*/
+static voidptr
+cgcs_vector_segmented_find(vector_segmented_t *self, cgcs_vector_segmented_cmp_t cmp,
+                           const void *valaddr) {
+    for (size_t k = 0; k < self->m_nsegs; k++) {
+        char *it = (char *)self->m_segs[k];
+        char *const end = it + self->m_elem_size * cgcs_vector_segmented_seg_size(self, k);
+
+        for (; it < end; it += self->m_elem_size) {
+            if (cgcs_vector_segmented_compare(cmp, it, valaddr) == 0) {
+                return it;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  cmpfn
+    \param[in]  valaddr
+
+    \return     address of the first matching block, or NULL if there is none
+*/
+voidptr vector_segmented_find(vector_segmented_t *self,
+                              int (*cmpfn)(const void *, const void *), const void *valaddr) {
+    const struct cgcs_vector_segmented_cmp cmp = { .m_fn = cmpfn, .m_b = NULL };
+    return cgcs_vector_segmented_find(self, &cmp, valaddr);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  cmp_b
+    \param[in]  valaddr
+
+    \return     address of the first matching block, or NULL if there is none
+*/
+voidptr vector_segmented_find_b(vector_segmented_t *self,
+                                int (^cmp_b)(const void *, const void *), const void *valaddr) {
+    const struct cgcs_vector_segmented_cmp cmp = { .m_fn = NULL, .m_b = cmp_b };
+    return cgcs_vector_segmented_find(self, &cmp, valaddr);
+}
+
+/*!
+    \brief      Sorts the n blocks of segment k in place
+
+    Vectors of pointers are sorted directly; others sort the addresses
+    of their blocks, then gather the blocks through scratch.
+
+    \param[in]  self
+    \param[in]  k
+    \param[in]  n
+    \param[in]  cmp
+    \param[in]  scratch     room for n blocks
+    \param[in]  addrs       room for n addresses (vectors of pointers: unused)
+*/
+static void
+cgcs_vector_segmented_sort_seg(vector_segmented_t *self, size_t k, size_t n,
+                               cgcs_vector_segmented_cmp_t cmp, char *scratch, voidptr *addrs) {
+    const size_t elem_size = self->m_elem_size;
+    char *seg = (char *)self->m_segs[k];
+
+    if (elem_size == sizeof(voidptr)) {
+        cgcs_vector_segmented_sort_pdqsort((voidptr *)seg, (voidptr *)seg + n, cmp);
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        addrs[i] = seg + elem_size * i;
+    }
+
+    cgcs_vector_segmented_sort_indirect_pdqsort(addrs, addrs + n, cmp);
+
+    for (size_t i = 0; i < n; i++) {
+        memcpy(scratch + elem_size * i, addrs[i], elem_size);
+    }
+
+    memcpy(seg, scratch, elem_size * n);
+}
+
+/*!
+    \brief      Merges sorted segment k into the sorted blocks before it
+
+    The blocks before segment k are moved out to scratch, then merged
+    with segment k back into place. Writing never overtakes reading:
+    after i blocks from scratch and j from segment k, the next write
+    is at i + j, and the next read from segment k is further along.
+
+    \param[in]  self
+    \param[in]  k
+    \param[in]  cmp
+    \param[in]  scratch     room for every block before segment k
+*/
+static void
+cgcs_vector_segmented_merge_seg(vector_segmented_t *self, size_t k,
+                                cgcs_vector_segmented_cmp_t cmp, char *scratch) {
+    const size_t elem_size = self->m_elem_size;
+    const size_t nleft = vector_segmented_seg_first(self, k);
+    const char *right = (const char *)self->m_segs[k];
+    const char *right_end = right + elem_size * cgcs_vector_segmented_seg_size(self, k);
+    const char *left = scratch;
+    const char *left_end = scratch + elem_size * nleft;
+
+    size_t out_k = 0;
+    char *out = (char *)self->m_segs[0];
+    char *out_end = out + elem_size * vector_segmented_seg_capacity(self, 0);
+
+    for (size_t j = 0; j < k; j++) {
+        memcpy(scratch + elem_size * vector_segmented_seg_first(self, j), self->m_segs[j],
+               elem_size * vector_segmented_seg_capacity(self, j));
+    }
+
+    // Once the left run is used up, what is left of the right run is in place.
+    while (left < left_end) {
+        const char *src = NULL;
+
+        if (out == out_end) {
+            ++out_k;
+            out = (char *)self->m_segs[out_k];
+            out_end = out + elem_size * vector_segmented_seg_capacity(self, out_k);
+        }
+
+        // Ties go to the left run, which came first.
+        if (right < right_end && cgcs_vector_segmented_compare(cmp, right, left) < 0) {
+            src = right;
+            right += elem_size;
+        } else {
+            src = left;
+            left += elem_size;
+        }
+
+        cgcs_vector_segmented_assign(self, out, src);
+        out += elem_size;
+    }
+}
+
+/*!
+    \brief      Sorts every segment, then merges them from the smallest up
+
+    Scratch space is about as large as the last segment in use,
+    i.e. up to half of the blocks.
+
+    \param[in]  self
+    \param[in]  cmp
+*/
+static void
+cgcs_vector_segmented_qsort(vector_segmented_t *self, cgcs_vector_segmented_cmp_t cmp) {
+    const vector_allocator_t *alloc = self->m_alloc;
+    const size_t elem_size = self->m_elem_size;
+    size_t nsegs = 0;
+    size_t scratch_n = 0;
+    char *scratch = NULL;
+    voidptr *addrs = NULL;
+
+    if (self->m_size < 2) {
+        return;
+    }
+
+    nsegs = vector_segmented_seg_of(self, self->m_size - 1) + 1;
+
+    // The largest of: the blocks before the last segment (to merge),
+    // and the blocks in the last segment (to sort).
+    scratch_n = vector_segmented_seg_first(self, nsegs - 1);
+
+    if (cgcs_vector_segmented_seg_size(self, nsegs - 1) > scratch_n) {
+        scratch_n = cgcs_vector_segmented_seg_size(self, nsegs - 1);
+    }
+
+    scratch = alloc->m_allocfn(alloc->m_ctx, elem_size * scratch_n);
+    assert(scratch);
+
+    if (elem_size != sizeof(voidptr)) {
+        addrs = alloc->m_allocfn(alloc->m_ctx, sizeof *addrs * scratch_n);
+        assert(addrs);
+    }
+
+    for (size_t k = 0; k < nsegs; k++) {
+        cgcs_vector_segmented_sort_seg(self, k, cgcs_vector_segmented_seg_size(self, k),
+                                       cmp, scratch, addrs);
+    }
+
+    for (size_t k = 1; k < nsegs; k++) {
+        cgcs_vector_segmented_merge_seg(self, k, cmp, scratch);
+    }
+
+    if (addrs) {
+        alloc->m_freefn(alloc->m_ctx, addrs, sizeof *addrs * scratch_n);
+    }
+
+    alloc->m_freefn(alloc->m_ctx, scratch, elem_size * scratch_n);
+}
+
+/*!
+    \brief      Sorts the blocks of self (not stable)
+
+    cmpfn is called with the addresses of two blocks, as in vector_qsort.
+
+    \param[in]  self
+    \param[in]  cmpfn
+*/
+void vector_segmented_qsort(vector_segmented_t *self, int (*cmpfn)(const void *, const void *)) {
+    const struct cgcs_vector_segmented_cmp cmp = { .m_fn = cmpfn, .m_b = NULL };
+    cgcs_vector_segmented_qsort(self, &cmp);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+    \param[in]  cmp_b
+*/
+void vector_segmented_qsort_b(vector_segmented_t *self, int (^cmp_b)(const void *, const void *)) {
+    const struct cgcs_vector_segmented_cmp cmp = { .m_fn = NULL, .m_b = cmp_b };
+    cgcs_vector_segmented_qsort(self, &cmp);
+}
@@ -0,0 +1,198 @@
+/*!
+    \file       cgcs_vector_segmented.h
+    \brief      Header file for a segmented vector, whose blocks never move
+                as it grows
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_SEGMENTED_H
+#define CGCS_VECTOR_SEGMENTED_H
+
+#include "cgcs_vector.h"
+
+// Segments a vector_segmented_t can have; segment k holds capacity << k blocks.
+#define CGCS_VECTOR_SEGMENTED_SEGMENTS 48
+
+/*!
+    \typedef
+    \brief
+*/
+typedef struct cgcs_vector_segmented vector_segmented_t;
+
+/*!
+    \struct
+    \brief      A vector stored as a directory of segments,
+                each twice the size of the one before it
+
+    Growing allocates one more segment and copies nothing:
+    a block keeps its address for as long as it is in the vector,
+    so the addresses returned by vector_segmented_at (and push_back)
+    stay valid as the vector grows. The directory is a fixed array,
+    so it never moves either.
+
+    Block i is found in O(1): with c = 2^m_shift blocks in segment 0,
+    it lives in segment k = floor(log2(i / c + 1)), at offset
+    i - c * (2^k - 1) -- one count-leading-zeros and a few shifts.
+
+    The blocks are not contiguous, so vector_segmented_foreach and
+    vector_segmented_find run segment by segment, and
+    vector_segmented_qsort sorts each segment, then merges them.
+*/
+struct cgcs_vector_segmented {
+    voidptr *m_segs[CGCS_VECTOR_SEGMENTED_SEGMENTS];
+    size_t m_nsegs;             // segments allocated
+    size_t m_size;
+    size_t m_shift;             // log2 of the capacity of segment 0
+    size_t m_elem_size;
+    const vector_allocator_t *m_alloc;
+};
+
+void vector_segmented_init(vector_segmented_t *self, size_t capacity);
+void vector_segmented_init_elem(vector_segmented_t *self, size_t capacity, size_t elem_size);
+void vector_segmented_init_allocator(vector_segmented_t *self, size_t capacity,
+                                     const vector_allocator_t *alloc);
+void vector_segmented_init_elem_allocator(vector_segmented_t *self, size_t capacity,
+                                          size_t elem_size, const vector_allocator_t *alloc);
+
+void vector_segmented_deinit(vector_segmented_t *self);
+
+voidptr vector_segmented_push_back(vector_segmented_t *self, const void *valaddr);
+void vector_segmented_append_n(vector_segmented_t *self, const void *src, size_t n);
+void vector_segmented_pop_back(vector_segmented_t *self);
+
+void vector_segmented_clear(vector_segmented_t *self);
+void vector_segmented_shrink_to_fit(vector_segmented_t *self);
+
+void vector_segmented_foreach(vector_segmented_t *self, void (*func)(void *));
+void vector_segmented_foreach_b(vector_segmented_t *self, void (^block)(void *));
+
+voidptr vector_segmented_find(vector_segmented_t *self,
+                              int (*cmpfn)(const void *, const void *), const void *valaddr);
+voidptr vector_segmented_find_b(vector_segmented_t *self,
+                                int (^cmp_b)(const void *, const void *), const void *valaddr);
+
+void vector_segmented_qsort(vector_segmented_t *self, int (*cmpfn)(const void *, const void *));
+void vector_segmented_qsort_b(vector_segmented_t *self, int (^cmp_b)(const void *, const void *));
+
+static size_t vector_segmented_seg_of(vector_segmented_t *self, size_t index);
+static size_t vector_segmented_seg_first(vector_segmented_t *self, size_t k);
+static size_t vector_segmented_seg_capacity(vector_segmented_t *self, size_t k);
+
+static voidptr vector_segmented_at(vector_segmented_t *self, size_t index);
+static voidptr vector_segmented_front(vector_segmented_t *self);
+static voidptr vector_segmented_back(vector_segmented_t *self);
+
+static size_t vector_segmented_size(vector_segmented_t *self);
+static size_t vector_segmented_capacity(vector_segmented_t *self);
+static bool vector_segmented_empty(vector_segmented_t *self);
+
+/*!
+    \brief      Returns the segment holding block index
+
+    \param[in]  self
+    \param[in]  index
+
+    \return
+*/
+static inline size_t vector_segmented_seg_of(vector_segmented_t *self, size_t index) {
+    const unsigned long long q = (index >> self->m_shift) + 1;
+    return (size_t)(sizeof q * 8 - 1 - __builtin_clzll(q));
+}
+
+/*!
+    \brief      Returns the index of the first block of segment k
+
+    \param[in]  self
+    \param[in]  k
+
+    \return
+*/
+static inline size_t vector_segmented_seg_first(vector_segmented_t *self, size_t k) {
+    return (((size_t)1 << k) - 1) << self->m_shift;
+}
+
+/*!
+    \brief      Returns the number of blocks segment k holds
+
+    \param[in]  self
+    \param[in]  k
+
+    \return
+*/
+static inline size_t vector_segmented_seg_capacity(vector_segmented_t *self, size_t k) {
+    return (size_t)1 << (self->m_shift + k);
+}
+
+/*!
+    \brief      Returns the address of block index -- the counterpart of vector_i
+
+    \param[in]  self
+    \param[in]  index
+
+    \return
+*/
+static inline voidptr vector_segmented_at(vector_segmented_t *self, size_t index) {
+    const size_t k = vector_segmented_seg_of(self, index);
+    const size_t offset = index - vector_segmented_seg_first(self, k);
+
+    return (char *)self->m_segs[k] + offset * self->m_elem_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline voidptr vector_segmented_front(vector_segmented_t *self) {
+    return vector_segmented_at(self, 0);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline voidptr vector_segmented_back(vector_segmented_t *self) {
+    return vector_segmented_at(self, self->m_size - 1);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_segmented_size(vector_segmented_t *self) {
+    return self->m_size;
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline size_t vector_segmented_capacity(vector_segmented_t *self) {
+    return vector_segmented_seg_first(self, self->m_nsegs);
+}
+
+/*!
+    \brief
+
+    \param[in]  self
+
+    \return
+*/
+static inline bool vector_segmented_empty(vector_segmented_t *self) {
+    return self->m_size == 0;
+}
+
+#endif /* CGCS_VECTOR_SEGMENTED_H */
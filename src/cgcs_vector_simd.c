@@ -0,0 +1,321 @@
+/*!
+    \file       cgcs_vector_simd.c
+    \brief      Source file for vector_find_ptr/vector_count_ptr,
+                with SSE2, AVX2 and AVX-512 kernels chosen at runtime
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+ */
+
+#include "cgcs_vector.h"
+
+#include <assert.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CGCS_VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define CGCS_VECTOR_SIMD_X86 0
+#endif
+
+/*!
+    \enum
+    \brief      Instruction sets the kernels below are written for,
+                in increasing order of preference
+*/
+enum cgcs_vector_simd_level {
+    CGCS_VECTOR_SIMD_UNKNOWN = 0,
+    CGCS_VECTOR_SIMD_SCALAR,
+    CGCS_VECTOR_SIMD_SSE2,
+    CGCS_VECTOR_SIMD_AVX2,
+    CGCS_VECTOR_SIMD_AVX512
+};
+
+/*!
+    \brief      Returns the best level the running CPU supports,
+                probing it only on the first call
+
+    \return
+*/
+static enum cgcs_vector_simd_level cgcs_vector_simd_level(void) {
+    static int level = CGCS_VECTOR_SIMD_UNKNOWN;
+    int cached = __atomic_load_n(&level, __ATOMIC_RELAXED);
+
+    if (cached == CGCS_VECTOR_SIMD_UNKNOWN) {
+#if CGCS_VECTOR_SIMD_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f")) {
+            cached = CGCS_VECTOR_SIMD_AVX512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            cached = CGCS_VECTOR_SIMD_AVX2;
+        } else {
+            // Every x86-64 CPU has SSE2.
+            cached = CGCS_VECTOR_SIMD_SSE2;
+        }
+#else
+        cached = CGCS_VECTOR_SIMD_SCALAR;
+#endif
+        // Every thread that races here computes the same value.
+        __atomic_store_n(&level, cached, __ATOMIC_RELAXED);
+    }
+
+    return cached;
+}
+
+/*
+    Each kernel looks for ptr among the n slots at first.
+    find_* returns the index of the first match (n if none);
+    count_* returns the number of matches.
+*/
+
+static size_t
+cgcs_vector_find_ptr_scalar(const voidptr *first, size_t n, const void *ptr) {
+    size_t i = 0;
+
+    while (i < n && first[i] != ptr) {
+        ++i;
+    }
+
+    return i;
+}
+
+static size_t
+cgcs_vector_count_ptr_scalar(const voidptr *first, size_t n, const void *ptr) {
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        count += first[i] == ptr;
+    }
+
+    return count;
+}
+
+#if CGCS_VECTOR_SIMD_X86
+
+/*!
+    \brief      Compares the two 64-bit lanes of v with needle
+
+    SSE2 has no 64-bit compare: a lane matches
+    if both of its 32-bit halves match.
+
+    \param[in]  v
+    \param[in]  needle
+
+    \return     2-bit mask, one bit per lane
+*/
+static inline int cgcs_vector_sse2_match(__m128i v, __m128i needle) {
+    const __m128i eq32 = _mm_cmpeq_epi32(v, needle);
+    const __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return _mm_movemask_pd(_mm_castsi128_pd(eq64));
+}
+
+static size_t
+cgcs_vector_find_ptr_sse2(const voidptr *first, size_t n, const void *ptr) {
+    const __m128i needle = _mm_set1_epi64x((long long)(uintptr_t)ptr);
+    size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        const int mask = cgcs_vector_sse2_match(_mm_loadu_si128((const __m128i *)(first + i)), needle)
+                       | cgcs_vector_sse2_match(_mm_loadu_si128((const __m128i *)(first + i + 2)), needle) << 2
+                       | cgcs_vector_sse2_match(_mm_loadu_si128((const __m128i *)(first + i + 4)), needle) << 4
+                       | cgcs_vector_sse2_match(_mm_loadu_si128((const __m128i *)(first + i + 6)), needle) << 6;
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + cgcs_vector_find_ptr_scalar(first + i, n - i, ptr);
+}
+
+static size_t
+cgcs_vector_count_ptr_sse2(const voidptr *first, size_t n, const void *ptr) {
+    const __m128i needle = _mm_set1_epi64x((long long)(uintptr_t)ptr);
+    size_t count = 0;
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        count += __builtin_popcount(
+            cgcs_vector_sse2_match(_mm_loadu_si128((const __m128i *)(first + i)), needle));
+    }
+
+    return count + cgcs_vector_count_ptr_scalar(first + i, n - i, ptr);
+}
+
+__attribute__((target("avx2")))
+static inline int cgcs_vector_avx2_match(__m256i v, __m256i needle) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, needle)));
+}
+
+__attribute__((target("avx2")))
+static size_t
+cgcs_vector_find_ptr_avx2(const voidptr *first, size_t n, const void *ptr) {
+    const __m256i needle = _mm256_set1_epi64x((long long)(uintptr_t)ptr);
+    size_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        const int mask = cgcs_vector_avx2_match(_mm256_loadu_si256((const __m256i *)(first + i)), needle)
+                       | cgcs_vector_avx2_match(_mm256_loadu_si256((const __m256i *)(first + i + 4)), needle) << 4
+                       | cgcs_vector_avx2_match(_mm256_loadu_si256((const __m256i *)(first + i + 8)), needle) << 8
+                       | cgcs_vector_avx2_match(_mm256_loadu_si256((const __m256i *)(first + i + 12)), needle) << 12;
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return i + cgcs_vector_find_ptr_sse2(first + i, n - i, ptr);
+}
+
+__attribute__((target("avx2")))
+static size_t
+cgcs_vector_count_ptr_avx2(const voidptr *first, size_t n, const void *ptr) {
+    const __m256i needle = _mm256_set1_epi64x((long long)(uintptr_t)ptr);
+    __m256i counts = _mm256_setzero_si256();
+    size_t count = 0;
+    size_t i = 0;
+
+    // Matching lanes are all ones (-1): subtracting them counts per lane.
+    for (; i + 4 <= n; i += 4) {
+        counts = _mm256_sub_epi64(counts,
+            _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(first + i)), needle));
+    }
+
+    count = (size_t)(_mm256_extract_epi64(counts, 0) + _mm256_extract_epi64(counts, 1)
+                   + _mm256_extract_epi64(counts, 2) + _mm256_extract_epi64(counts, 3));
+
+    return count + cgcs_vector_count_ptr_scalar(first + i, n - i, ptr);
+}
+
+__attribute__((target("avx512f")))
+static size_t
+cgcs_vector_find_ptr_avx512(const voidptr *first, size_t n, const void *ptr) {
+    const __m512i needle = _mm512_set1_epi64((long long)(uintptr_t)ptr);
+    size_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        const unsigned mask =
+              (unsigned)_mm512_cmpeq_epi64_mask(_mm512_loadu_si512(first + i), needle)
+            | (unsigned)_mm512_cmpeq_epi64_mask(_mm512_loadu_si512(first + i + 8), needle) << 8
+            | (unsigned)_mm512_cmpeq_epi64_mask(_mm512_loadu_si512(first + i + 16), needle) << 16
+            | (unsigned)_mm512_cmpeq_epi64_mask(_mm512_loadu_si512(first + i + 24), needle) << 24;
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    // Masked loads never touch the slots past the end.
+    for (; i < n; i += 8) {
+        const __mmask8 live = n - i >= 8 ? 0xff : (__mmask8)((1u << (n - i)) - 1);
+        const __mmask8 mask = _mm512_mask_cmpeq_epi64_mask(
+            live, _mm512_maskz_loadu_epi64(live, first + i), needle);
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return n;
+}
+
+__attribute__((target("avx512f")))
+static size_t
+cgcs_vector_count_ptr_avx512(const voidptr *first, size_t n, const void *ptr) {
+    const __m512i needle = _mm512_set1_epi64((long long)(uintptr_t)ptr);
+    size_t count = 0;
+
+    for (size_t i = 0; i < n; i += 8) {
+        const __mmask8 live = n - i >= 8 ? 0xff : (__mmask8)((1u << (n - i)) - 1);
+
+        count += __builtin_popcount(_mm512_mask_cmpeq_epi64_mask(
+            live, _mm512_maskz_loadu_epi64(live, first + i), needle));
+    }
+
+    return count;
+}
+
+#endif /* CGCS_VECTOR_SIMD_X86 */
+
+/*!
+    \brief      Returns the first slot in [beg, end) holding exactly ptr
+
+    Compares the pointers themselves (no comparator), 8 to 32 slots at a time
+    with the widest of SSE2, AVX2 or AVX-512 the CPU supports.
+    Requires a vector made with vector_init (blocks are pointers).
+
+    \param[in]  self
+    \param[in]  ptr
+    \param[in]  beg
+    \param[in]  end
+
+    \return     iterator to the slot, or NULL if there is none
+*/
+vector_iterator_t vector_find_ptr_range(vector_t *self, const void *ptr,
+                                        vector_iterator_t beg, vector_iterator_t end) {
+    const size_t n = end - beg;
+    size_t i = n;
+
+    assert(vector_elem_size(self) == sizeof(voidptr));
+
+    switch (cgcs_vector_simd_level()) {
+#if CGCS_VECTOR_SIMD_X86
+    case CGCS_VECTOR_SIMD_AVX512:
+        i = cgcs_vector_find_ptr_avx512(beg, n, ptr);
+        break;
+    case CGCS_VECTOR_SIMD_AVX2:
+        i = cgcs_vector_find_ptr_avx2(beg, n, ptr);
+        break;
+    case CGCS_VECTOR_SIMD_SSE2:
+        i = cgcs_vector_find_ptr_sse2(beg, n, ptr);
+        break;
+#endif
+    default:
+        i = cgcs_vector_find_ptr_scalar(beg, n, ptr);
+        break;
+    }
+
+    return i == n ? NULL : beg + i;
+}
+
+vector_iterator_t vector_find_ptr(vector_t *self, const void *ptr) {
+    return vector_find_ptr_range(self, ptr, vector_begin(self), vector_end(self));
+}
+
+/*!
+    \brief      Counts the slots in [beg, end) holding exactly ptr
+
+    See vector_find_ptr_range.
+
+    \param[in]  self
+    \param[in]  ptr
+    \param[in]  beg
+    \param[in]  end
+
+    \return
+*/
+size_t vector_count_ptr_range(vector_t *self, const void *ptr,
+                              vector_iterator_t beg, vector_iterator_t end) {
+    const size_t n = end - beg;
+
+    assert(vector_elem_size(self) == sizeof(voidptr));
+
+    switch (cgcs_vector_simd_level()) {
+#if CGCS_VECTOR_SIMD_X86
+    case CGCS_VECTOR_SIMD_AVX512:
+        return cgcs_vector_count_ptr_avx512(beg, n, ptr);
+    case CGCS_VECTOR_SIMD_AVX2:
+        return cgcs_vector_count_ptr_avx2(beg, n, ptr);
+    case CGCS_VECTOR_SIMD_SSE2:
+        return cgcs_vector_count_ptr_sse2(beg, n, ptr);
+#endif
+    default:
+        return cgcs_vector_count_ptr_scalar(beg, n, ptr);
+    }
+}
+
+size_t vector_count_ptr(vector_t *self, const void *ptr) {
+    return vector_count_ptr_range(self, ptr, vector_begin(self), vector_end(self));
+}
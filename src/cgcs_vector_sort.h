@@ -0,0 +1,537 @@
+/*!
+    \file       cgcs_vector_sort.h
+    \brief      Header file for the sort engine behind the vector_*sort* family
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_SORT_H
+#define CGCS_VECTOR_SORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*!
+    \brief      Defines a family of sort functions for arrays of T
+
+    Expands to static inline functions, prefixed with name:
+
+    - name_pdqsort(T *first, T *last, ctx_t ctx)
+        pattern-defeating quicksort; unstable, O(n log n) worst case,
+        O(n) for sorted, reversed and many-duplicate inputs
+    - name_mergesort(T *first, T *last, T *scratch, ctx_t ctx)
+        stable; scratch must hold at least (last - first) / 2 elements,
+        and may be reused between calls
+    - name_heapsort(T *first, T *last, ctx_t ctx)
+        unstable, O(n log n), needs no extra memory
+    - name_insertion_sort(T *first, T *last, ctx_t ctx)
+        stable, for short ranges
+    - name_merge(T *a, T *a_last, T *b, T *b_last, T *out, ctx_t ctx)
+        stable merge of two sorted ranges into out; out must not overlap
+        [a, a_last), and may only overlap [b, b_last) from below
+        (out + (a_last - a) <= b), as in an in-place merge
+
+    less(ctx, a, b) is an expression, or the name of a macro/function,
+    that yields true if *a must come before *b (a and b are T *).
+    ctx is passed through untouched; it can carry a comparator, or be unused.
+
+    Because T and less are known at compile time, the compiler can inline
+    the comparison and move elements with plain assignments.
+
+    \code
+        #define int_less(ctx, a, b) (*(a) < *(b))
+        CGCS_VECTOR_SORT_DEFINE(int_sort, int, void *, int_less)
+
+        int_sort_pdqsort(arr, arr + len, NULL);
+    \endcode
+*/
+#define CGCS_VECTOR_SORT_DEFINE(name, T, ctx_t, less)                          \
+                                                                               \
+    static inline void name##_swap(T *a, T *b) {                               \
+        T tmp = *a;                                                            \
+        *a = *b;                                                               \
+        *b = tmp;                                                              \
+    }                                                                          \
+                                                                               \
+    static inline void name##_sort2(T *a, T *b, ctx_t ctx) {                   \
+        if (less(ctx, b, a)) {                                                 \
+            name##_swap(a, b);                                                 \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_sort3(T *a, T *b, T *c, ctx_t ctx) {             \
+        name##_sort2(a, b, ctx);                                               \
+        name##_sort2(b, c, ctx);                                               \
+        name##_sort2(a, b, ctx);                                               \
+    }                                                                          \
+                                                                               \
+    static inline void name##_insertion_sort(T *first, T *last, ctx_t ctx) {   \
+        if (first == last) {                                                   \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        for (T *cur = first + 1; cur != last; ++cur) {                         \
+            T *sift = cur;                                                     \
+            T *sift_1 = cur - 1;                                               \
+                                                                               \
+            if (less(ctx, sift, sift_1)) {                                     \
+                T tmp = *sift;                                                 \
+                                                                               \
+                do {                                                           \
+                    *sift-- = *sift_1;                                         \
+                } while (sift != first && less(ctx, &tmp, --sift_1));          \
+                                                                               \
+                *sift = tmp;                                                   \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Assumes *(first - 1) is not greater than anything in [first, last). */  \
+    static inline void name##_unguarded_insertion_sort(T *first, T *last,      \
+                                                       ctx_t ctx) {            \
+        if (first == last) {                                                   \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        for (T *cur = first + 1; cur != last; ++cur) {                         \
+            T *sift = cur;                                                     \
+            T *sift_1 = cur - 1;                                               \
+                                                                               \
+            if (less(ctx, sift, sift_1)) {                                     \
+                T tmp = *sift;                                                 \
+                                                                               \
+                do {                                                           \
+                    *sift-- = *sift_1;                                         \
+                } while (less(ctx, &tmp, --sift_1));                           \
+                                                                               \
+                *sift = tmp;                                                   \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Gives up (returning false) once more than 8 elements were moved. */     \
+    static inline bool name##_partial_insertion_sort(T *first, T *last,        \
+                                                     ctx_t ctx) {              \
+        size_t limit = 0;                                                      \
+                                                                               \
+        if (first == last) {                                                   \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        for (T *cur = first + 1; cur != last; ++cur) {                         \
+            T *sift = cur;                                                     \
+            T *sift_1 = cur - 1;                                               \
+                                                                               \
+            if (less(ctx, sift, sift_1)) {                                     \
+                T tmp = *sift;                                                 \
+                                                                               \
+                do {                                                           \
+                    *sift-- = *sift_1;                                         \
+                } while (sift != first && less(ctx, &tmp, --sift_1));          \
+                                                                               \
+                *sift = tmp;                                                   \
+                limit += cur - sift;                                           \
+            }                                                                  \
+                                                                               \
+            if (limit > 8) {                                                   \
+                return false;                                                  \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline void name##_sift_down(T *first, size_t n, size_t i,         \
+                                        ctx_t ctx) {                           \
+        T tmp = first[i];                                                      \
+        size_t child = 0;                                                      \
+                                                                               \
+        while ((child = 2 * i + 1) < n) {                                      \
+            if (child + 1 < n && less(ctx, first + child, first + child + 1)) {\
+                ++child;                                                       \
+            }                                                                  \
+                                                                               \
+            if (less(ctx, &tmp, first + child) == false) {                     \
+                break;                                                         \
+            }                                                                  \
+                                                                               \
+            first[i] = first[child];                                           \
+            i = child;                                                         \
+        }                                                                      \
+                                                                               \
+        first[i] = tmp;                                                        \
+    }                                                                          \
+                                                                               \
+    static inline void name##_heapsort(T *first, T *last, ctx_t ctx) {         \
+        size_t n = last - first;                                               \
+                                                                               \
+        for (size_t i = n / 2; i-- > 0;) {                                     \
+            name##_sift_down(first, n, i, ctx);                                \
+        }                                                                      \
+                                                                               \
+        while (n > 1) {                                                        \
+            name##_swap(first, first + --n);                                   \
+            name##_sift_down(first, n, 0, ctx);                                \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Partitions around *first; elements equal to the pivot go right. */     \
+    /* Sets *already_partitioned if no elements had to be swapped. */          \
+    static inline T *name##_partition_right(T *first, T *last,                \
+                                            bool *already_partitioned,         \
+                                            ctx_t ctx) {                       \
+        T pivot = *first;                                                      \
+        T *begin = first;                                                      \
+        T *pivot_pos = NULL;                                                   \
+                                                                               \
+        while (less(ctx, ++first, &pivot)) {                                   \
+        }                                                                      \
+                                                                               \
+        if (first - 1 == begin) {                                              \
+            while (first < last && less(ctx, --last, &pivot) == false) {       \
+            }                                                                  \
+        } else {                                                               \
+            while (less(ctx, --last, &pivot) == false) {                       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        *already_partitioned = first >= last;                                  \
+                                                                               \
+        while (first < last) {                                                 \
+            name##_swap(first, last);                                          \
+                                                                               \
+            while (less(ctx, ++first, &pivot)) {                               \
+            }                                                                  \
+                                                                               \
+            while (less(ctx, --last, &pivot) == false) {                       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        pivot_pos = first - 1;                                                 \
+        *begin = *pivot_pos;                                                   \
+        *pivot_pos = pivot;                                                    \
+                                                                               \
+        return pivot_pos;                                                      \
+    }                                                                          \
+                                                                               \
+    /* Partitions around *first; elements equal to the pivot go left. */      \
+    /* Used when the pivot equals its predecessor (many duplicates). */        \
+    static inline T *name##_partition_left(T *first, T *last, ctx_t ctx) {    \
+        T pivot = *first;                                                      \
+        T *begin = first;                                                      \
+        T *end = last;                                                         \
+        T *pivot_pos = NULL;                                                   \
+                                                                               \
+        while (less(ctx, &pivot, --last)) {                                    \
+        }                                                                      \
+                                                                               \
+        if (last + 1 == end) {                                                 \
+            while (first < last && less(ctx, &pivot, ++first) == false) {      \
+            }                                                                  \
+        } else {                                                               \
+            while (less(ctx, &pivot, ++first) == false) {                      \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        while (first < last) {                                                 \
+            name##_swap(first, last);                                          \
+                                                                               \
+            while (less(ctx, &pivot, --last)) {                                \
+            }                                                                  \
+                                                                               \
+            while (less(ctx, &pivot, ++first) == false) {                      \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        pivot_pos = last;                                                      \
+        *begin = *pivot_pos;                                                   \
+        *pivot_pos = pivot;                                                    \
+                                                                               \
+        return pivot_pos;                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_pdqsort_loop(T *first, T *last, int bad_allowed, \
+                                           bool leftmost, ctx_t ctx) {         \
+        for (;;) {                                                             \
+            const size_t size = last - first;                                  \
+            const size_t s2 = size / 2;                                        \
+            bool already_partitioned = false;                                  \
+            T *pivot_pos = NULL;                                               \
+            size_t l_size = 0;                                                 \
+            size_t r_size = 0;                                                 \
+                                                                               \
+            if (size < 24) {                                                   \
+                if (leftmost) {                                                \
+                    name##_insertion_sort(first, last, ctx);                   \
+                } else {                                                       \
+                    name##_unguarded_insertion_sort(first, last, ctx);         \
+                }                                                              \
+                                                                               \
+                return;                                                        \
+            }                                                                  \
+                                                                               \
+            /* Median of 3 -- or Tukey's ninther, for larger ranges. */        \
+            if (size > 128) {                                                  \
+                name##_sort3(first, first + s2, last - 1, ctx);                \
+                name##_sort3(first + 1, first + (s2 - 1), last - 2, ctx);      \
+                name##_sort3(first + 2, first + (s2 + 1), last - 3, ctx);      \
+                name##_sort3(first + (s2 - 1), first + s2, first + (s2 + 1),   \
+                             ctx);                                             \
+                name##_swap(first, first + s2);                                \
+            } else {                                                           \
+                name##_sort3(first + s2, first, last - 1, ctx);                \
+            }                                                                  \
+                                                                               \
+            /* If the pivot equals the element before this range, */          \
+            /* every element equal to it can be put in place at once. */       \
+            if (leftmost == false && less(ctx, first - 1, first) == false) {   \
+                first = name##_partition_left(first, last, ctx) + 1;           \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            pivot_pos = name##_partition_right(first, last,                    \
+                                               &already_partitioned, ctx);     \
+            l_size = pivot_pos - first;                                        \
+            r_size = last - (pivot_pos + 1);                                   \
+                                                                               \
+            if (l_size < size / 8 || r_size < size / 8) {                      \
+                /* Too many bad partitions: fall back on heapsort. */          \
+                if (--bad_allowed == 0) {                                      \
+                    name##_heapsort(first, last, ctx);                         \
+                    return;                                                    \
+                }                                                              \
+                                                                               \
+                /* Otherwise, break up patterns that fooled the pivot. */      \
+                if (l_size >= 24) {                                            \
+                    name##_swap(first, first + l_size / 4);                    \
+                    name##_swap(pivot_pos - 1, pivot_pos - l_size / 4);        \
+                                                                               \
+                    if (l_size > 128) {                                        \
+                        name##_swap(first + 1, first + (l_size / 4 + 1));      \
+                        name##_swap(first + 2, first + (l_size / 4 + 2));      \
+                        name##_swap(pivot_pos - 2,                             \
+                                    pivot_pos - (l_size / 4 + 1));             \
+                        name##_swap(pivot_pos - 3,                             \
+                                    pivot_pos - (l_size / 4 + 2));             \
+                    }                                                          \
+                }                                                              \
+                                                                               \
+                if (r_size >= 24) {                                            \
+                    name##_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));  \
+                    name##_swap(last - 1, last - r_size / 4);                  \
+                                                                               \
+                    if (r_size > 128) {                                        \
+                        name##_swap(pivot_pos + 2,                             \
+                                    pivot_pos + (2 + r_size / 4));             \
+                        name##_swap(pivot_pos + 3,                             \
+                                    pivot_pos + (3 + r_size / 4));             \
+                        name##_swap(last - 2, last - (1 + r_size / 4));        \
+                        name##_swap(last - 3, last - (2 + r_size / 4));        \
+                    }                                                          \
+                }                                                              \
+            } else if (already_partitioned &&                                  \
+                       name##_partial_insertion_sort(first, pivot_pos, ctx) && \
+                       name##_partial_insertion_sort(pivot_pos + 1, last,      \
+                                                     ctx)) {                   \
+                /* Already sorted (or nearly); nothing left to do. */          \
+                return;                                                        \
+            }                                                                  \
+                                                                               \
+            /* Recurse on the left, loop on the right. */                      \
+            name##_pdqsort_loop(first, pivot_pos, bad_allowed, leftmost, ctx); \
+            first = pivot_pos + 1;                                             \
+            leftmost = false;                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_pdqsort(T *first, T *last, ctx_t ctx) {          \
+        int log2_size = 0;                                                     \
+                                                                               \
+        for (size_t n = last - first; n > 1; n >>= 1) {                        \
+            ++log2_size;                                                       \
+        }                                                                      \
+                                                                               \
+        if (last - first > 1) {                                                \
+            name##_pdqsort_loop(first, last, log2_size, true, ctx);            \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline T *name##_merge(T *a, T *a_last, T *b, T *b_last, T *out,    \
+                                  ctx_t ctx) {                                 \
+        while (a < a_last && b < b_last) {                                     \
+            /* Take from b only if strictly less, to remain stable. */         \
+            *out++ = less(ctx, b, a) ? *b++ : *a++;                            \
+        }                                                                      \
+                                                                               \
+        while (a < a_last) {                                                   \
+            *out++ = *a++;                                                     \
+        }                                                                      \
+                                                                               \
+        while (b < b_last) {                                                   \
+            *out++ = *b++;                                                     \
+        }                                                                      \
+                                                                               \
+        return out;                                                            \
+    }                                                                          \
+                                                                               \
+    static inline void name##_mergesort(T *first, T *last, T *scratch,         \
+                                        ctx_t ctx) {                           \
+        const size_t n = last - first;                                         \
+        T *mid = first + n / 2;                                                \
+        T *scratch_last = scratch;                                             \
+                                                                               \
+        if (n <= 16) {                                                         \
+            name##_insertion_sort(first, last, ctx);                           \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        name##_mergesort(first, mid, scratch, ctx);                            \
+        name##_mergesort(mid, last, scratch, ctx);                             \
+                                                                               \
+        /* The halves are already in order. */                                 \
+        if (less(ctx, mid, mid - 1) == false) {                                \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
+        /* Move the left half out of the way, then merge back into place. */  \
+        for (T *it = first; it < mid; ++it) {                                  \
+            *scratch_last++ = *it;                                             \
+        }                                                                      \
+                                                                               \
+        name##_merge(scratch, scratch_last, mid, last, first, ctx);            \
+    }
+
+/*
+    LSD radix sort on 64-bit keys, one byte (8 passes at most) at a time.
+    Keys are extracted once into an array of cgcs_vector_radix_item,
+    which is sorted (stably) in place of the blocks themselves.
+*/
+
+#define CGCS_VECTOR_RADIX_BITS 8
+#define CGCS_VECTOR_RADIX_BUCKETS (1 << CGCS_VECTOR_RADIX_BITS)
+#define CGCS_VECTOR_RADIX_PASSES (64 / CGCS_VECTOR_RADIX_BITS)
+
+/*!
+    \struct
+    \brief      A key, and the block (or block address) it was taken from
+*/
+struct cgcs_vector_radix_item {
+    uint64_t m_key;
+    void *m_ptr;
+};
+
+static inline size_t cgcs_vector_radix_digit(uint64_t key, size_t pass) {
+    return (size_t)(key >> (pass * CGCS_VECTOR_RADIX_BITS)) & (CGCS_VECTOR_RADIX_BUCKETS - 1);
+}
+
+/*!
+    \brief      Adds the count of every digit of every key in [first, last)
+                to hist (one row per pass)
+
+    \param[in]  first
+    \param[in]  last
+    \param[in]  hist
+*/
+static inline void
+cgcs_vector_radix_histogram(const struct cgcs_vector_radix_item *first,
+                            const struct cgcs_vector_radix_item *last,
+                            size_t hist[CGCS_VECTOR_RADIX_PASSES][CGCS_VECTOR_RADIX_BUCKETS]) {
+    for (; first < last; ++first) {
+        for (size_t pass = 0; pass < CGCS_VECTOR_RADIX_PASSES; pass++) {
+            ++hist[pass][cgcs_vector_radix_digit(first->m_key, pass)];
+        }
+    }
+}
+
+/*!
+    \brief      Returns true if every one of the n keys shares the same
+                digit for this pass (one bucket holds them all),
+                so the pass would not move anything
+
+    \param[in]  row    hist[pass], as filled by cgcs_vector_radix_histogram
+    \param[in]  n
+
+    \return
+*/
+static inline bool
+cgcs_vector_radix_trivial(const size_t row[CGCS_VECTOR_RADIX_BUCKETS], size_t n) {
+    for (size_t b = 0; b < CGCS_VECTOR_RADIX_BUCKETS; b++) {
+        if (row[b] != 0) {
+            return row[b] == n;
+        }
+    }
+
+    return true;
+}
+
+/*!
+    \brief      Moves [first, last) into dst, by digit,
+                with offsets[b] giving where the next item of bucket b goes
+
+    Items keep their relative order within a bucket (stable).
+
+    \param[in]  first
+    \param[in]  last
+    \param[in]  dst
+    \param[in]  offsets
+    \param[in]  pass
+*/
+static inline void
+cgcs_vector_radix_scatter(const struct cgcs_vector_radix_item *first,
+                          const struct cgcs_vector_radix_item *last,
+                          struct cgcs_vector_radix_item *dst,
+                          size_t offsets[CGCS_VECTOR_RADIX_BUCKETS], size_t pass) {
+    for (; first < last; ++first) {
+        dst[offsets[cgcs_vector_radix_digit(first->m_key, pass)]++] = *first;
+    }
+}
+
+/*!
+    \brief      Sorts the n items at items by key (stable)
+
+    scratch must hold n items.
+    Passes whose digit is the same for every key are skipped.
+
+    \param[in]  items
+    \param[in]  scratch
+    \param[in]  n
+
+    \return     items or scratch, whichever holds the sorted items
+*/
+static inline struct cgcs_vector_radix_item *
+cgcs_vector_radix_sort(struct cgcs_vector_radix_item *items,
+                       struct cgcs_vector_radix_item *scratch, size_t n) {
+    size_t hist[CGCS_VECTOR_RADIX_PASSES][CGCS_VECTOR_RADIX_BUCKETS];
+
+    memset(hist, 0, sizeof hist);
+    cgcs_vector_radix_histogram(items, items + n, hist);
+
+    for (size_t pass = 0; pass < CGCS_VECTOR_RADIX_PASSES; pass++) {
+        struct cgcs_vector_radix_item *tmp = NULL;
+        size_t sum = 0;
+
+        if (cgcs_vector_radix_trivial(hist[pass], n)) {
+            continue;
+        }
+
+        // Counts become the offset of each bucket's first item.
+        for (size_t b = 0; b < CGCS_VECTOR_RADIX_BUCKETS; b++) {
+            const size_t count = hist[pass][b];
+            hist[pass][b] = sum;
+            sum += count;
+        }
+
+        cgcs_vector_radix_scatter(items, items + n, scratch, hist[pass], pass);
+
+        tmp = items;
+        items = scratch;
+        scratch = tmp;
+    }
+
+    return items;
+}
+
+#endif /* CGCS_VECTOR_SORT_H */
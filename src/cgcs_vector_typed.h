@@ -0,0 +1,384 @@
+/*!
+    \file       cgcs_vector_typed.h
+    \brief      Header file for typed vectors, generated by CGCS_VECTOR_DEFINE
+
+    \author     Gemuele Aludino
+    \date       16 Oct 2026
+*/
+
+#ifndef CGCS_VECTOR_TYPED_H
+#define CGCS_VECTOR_TYPED_H
+
+#include "cgcs_vector.h"
+#include "cgcs_vector_sort.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*!
+    \brief      Defines name_t, a vector of T whose comparator is cmp
+
+    cmp has the signature int cmp(const T *, const T *), and returns
+    < 0, 0 or > 0 (as with qsort). It must be visible at the point
+    of definition; since its identity is known at compile time, it is
+    inlined into the search and sort loops rather than called indirectly.
+
+    The functions mirror those in cgcs_vector.h, prefixed with name
+    (i.e. name_push_back for vector_push_back), except that elements
+    are passed by value, and iterators (name_iterator_t) are plain T *.
+    Buffers are drawn from a vector_allocator_t, as with vector_t.
+
+    \code
+        static inline int int_compare(const int *a, const int *b) {
+            return (*a > *b) - (*a < *b);
+        }
+
+        CGCS_VECTOR_DEFINE(vector_int, int, int_compare)
+
+        vector_int_t vi;
+        vector_int_init(&vi, 16);
+
+        vector_int_push_back(&vi, 42);
+        vector_int_qsort(&vi);
+
+        int key = 42;
+        int *found = vector_int_find(&vi, &key);
+
+        vector_int_deinit(&vi);
+    \endcode
+*/
+#define CGCS_VECTOR_DEFINE(name, T, cmp)                                       \
+                                                                               \
+    typedef struct name name##_t;                                              \
+    typedef T *name##_iterator_t;                                              \
+                                                                               \
+    struct name {                                                              \
+        struct {                                                               \
+            T *m_start;                                                        \
+            T *m_finish;                                                       \
+            T *m_end_of_storage;                                               \
+            const vector_allocator_t *m_alloc;                                 \
+        } m_impl;                                                              \
+    };                                                                         \
+                                                                               \
+    static inline bool name##_less(void *ctx, const T *a, const T *b) {        \
+        (void)ctx;                                                             \
+        return cmp(a, b) < 0;                                                  \
+    }                                                                          \
+                                                                               \
+    CGCS_VECTOR_SORT_DEFINE(name##_sort, T, void *, name##_less)               \
+                                                                               \
+    static inline void name##_init_allocator(name##_t *self, size_t capacity,  \
+                                             const vector_allocator_t *alloc) {\
+        self->m_impl.m_alloc = alloc;                                          \
+        self->m_impl.m_start = alloc->m_allocfn(alloc->m_ctx,                  \
+                                                sizeof(T) * capacity);         \
+        assert(self->m_impl.m_start);                                          \
+        self->m_impl.m_finish = self->m_impl.m_start;                          \
+        self->m_impl.m_end_of_storage = self->m_impl.m_start + capacity;       \
+    }                                                                          \
+                                                                               \
+    static inline void name##_init(name##_t *self, size_t capacity) {          \
+        name##_init_allocator(self, capacity, &cgcs_vector_malloc_allocator);  \
+    }                                                                          \
+                                                                               \
+    static inline void name##_deinit(name##_t *self) {                         \
+        const vector_allocator_t *a = self->m_impl.m_alloc;                    \
+                                                                               \
+        if (self->m_impl.m_start) {                                            \
+            a->m_freefn(a->m_ctx, self->m_impl.m_start,                        \
+                        sizeof(T) * (self->m_impl.m_end_of_storage -           \
+                                     self->m_impl.m_start));                   \
+        }                                                                      \
+                                                                               \
+        self->m_impl.m_start = NULL;                                           \
+        self->m_impl.m_finish = NULL;                                          \
+        self->m_impl.m_end_of_storage = NULL;                                  \
+    }                                                                          \
+                                                                               \
+    static inline T *name##_front(name##_t *self) {                            \
+        return self->m_impl.m_start;                                           \
+    }                                                                          \
+                                                                               \
+    static inline T *name##_back(name##_t *self) {                             \
+        return self->m_impl.m_finish - 1;                                      \
+    }                                                                          \
+                                                                               \
+    static inline T *name##_at(name##_t *self, const int index) {              \
+        T *result = self->m_impl.m_start + index;                              \
+        return result >= self->m_impl.m_finish ? NULL : result;                \
+    }                                                                          \
+                                                                               \
+    static inline T *name##_i(name##_t *self, size_t index) {                  \
+        return self->m_impl.m_start + index;                                   \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_empty(name##_t *self) {                          \
+        return self->m_impl.m_start == self->m_impl.m_finish;                  \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_size(name##_t *self) {                         \
+        return self->m_impl.m_finish - self->m_impl.m_start;                   \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_capacity(name##_t *self) {                     \
+        return self->m_impl.m_end_of_storage - self->m_impl.m_start;           \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_begin(name##_t *self) {             \
+        return self->m_impl.m_start;                                           \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_end(name##_t *self) {               \
+        return self->m_impl.m_finish;                                          \
+    }                                                                          \
+                                                                               \
+    /* Reallocates the buffer to hold exactly capacity elements. */            \
+    static inline void name##_resize_block(name##_t *self, size_t capacity) {  \
+        const vector_allocator_t *a = self->m_impl.m_alloc;                    \
+        const size_t size = name##_size(self);                                 \
+        const size_t old_size = sizeof(T) * name##_capacity(self);             \
+        T *start = NULL;                                                       \
+                                                                               \
+        if (a->m_reallocfn) {                                                  \
+            start = a->m_reallocfn(a->m_ctx, self->m_impl.m_start, old_size,   \
+                                   sizeof(T) * capacity);                      \
+            assert(start);                                                     \
+        } else {                                                               \
+            start = a->m_allocfn(a->m_ctx, sizeof(T) * capacity);              \
+            assert(start);                                                     \
+            memcpy(start, self->m_impl.m_start, sizeof(T) * size);             \
+            a->m_freefn(a->m_ctx, self->m_impl.m_start, old_size);             \
+        }                                                                      \
+                                                                               \
+        self->m_impl.m_start = start;                                          \
+        self->m_impl.m_finish = start + size;                                  \
+        self->m_impl.m_end_of_storage = start + capacity;                      \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_resize(name##_t *self, size_t n) {               \
+        if (n <= name##_capacity(self)) {                                      \
+            return false;                                                      \
+        } else {                                                               \
+            name##_resize_block(self, n);                                      \
+            return true;                                                       \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_shrink_to_fit(name##_t *self) {                  \
+        const size_t n = name##_size(self) > 0 ? name##_size(self) : 1;        \
+                                                                               \
+        if (name##_capacity(self) > n) {                                       \
+            name##_resize_block(self, n);                                      \
+            return true;                                                       \
+        } else {                                                               \
+            return false;                                                      \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Grows (by a factor of 2, or more if needed) to hold required. */        \
+    static inline void name##_grow(name##_t *self, size_t required) {          \
+        const size_t next = name##_capacity(self) * 2;                         \
+        name##_resize_block(self, next < required ? required : next);          \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_insert(name##_t *self,              \
+                                                  name##_iterator_t it,        \
+                                                  T val) {                     \
+        if (self->m_impl.m_finish == self->m_impl.m_end_of_storage) {          \
+            const size_t position = it - self->m_impl.m_start;                 \
+            name##_grow(self, name##_size(self) + 1);                          \
+            it = self->m_impl.m_start + position;                              \
+        }                                                                      \
+                                                                               \
+        memmove(it + 1, it, sizeof *it * (self->m_impl.m_finish - it));        \
+        *it = val;                                                             \
+        ++self->m_impl.m_finish;                                               \
+                                                                               \
+        return it;                                                             \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_insert_range(name##_t *self,        \
+                                                        name##_iterator_t it,  \
+                                                        const T *beg,          \
+                                                        const T *end) {        \
+        const size_t count = end - beg;                                        \
+        const size_t required = name##_size(self) + count;                     \
+                                                                               \
+        if (required > name##_capacity(self)) {                                \
+            const size_t position = it - self->m_impl.m_start;                 \
+            name##_grow(self, required);                                       \
+            it = self->m_impl.m_start + position;                              \
+        }                                                                      \
+                                                                               \
+        memmove(it + count, it, sizeof *it * (self->m_impl.m_finish - it));    \
+        memcpy(it, beg, sizeof *it * count);                                   \
+        self->m_impl.m_finish += count;                                        \
+                                                                               \
+        return it;                                                             \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_erase(name##_t *self,               \
+                                                 name##_iterator_t it) {       \
+        if (name##_empty(self) == false) {                                     \
+            memmove(it, it + 1, sizeof *it * (self->m_impl.m_finish - it - 1));\
+            --self->m_impl.m_finish;                                           \
+        }                                                                      \
+                                                                               \
+        return it;                                                             \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_erase_range(name##_t *self,         \
+                                                       name##_iterator_t beg,  \
+                                                       name##_iterator_t end) {\
+        if (name##_empty(self) == false) {                                     \
+            memmove(beg, end, sizeof *beg * (self->m_impl.m_finish - end));    \
+            self->m_impl.m_finish -= end - beg;                                \
+        }                                                                      \
+                                                                               \
+        return beg;                                                            \
+    }                                                                          \
+                                                                               \
+    static inline void name##_push_back(name##_t *self, T val) {               \
+        if (self->m_impl.m_finish == self->m_impl.m_end_of_storage) {          \
+            name##_grow(self, name##_size(self) + 1);                          \
+        }                                                                      \
+                                                                               \
+        *(self->m_impl.m_finish++) = val;                                      \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_reserve_back(name##_t *self,        \
+                                                        size_t n) {            \
+        const size_t required = name##_size(self) + n;                         \
+                                                                               \
+        if (required > name##_capacity(self)) {                                \
+            name##_grow(self, required);                                       \
+        }                                                                      \
+                                                                               \
+        return self->m_impl.m_finish;                                          \
+    }                                                                          \
+                                                                               \
+    static inline void name##_commit_back(name##_t *self, size_t n) {          \
+        assert(self->m_impl.m_finish + n <= self->m_impl.m_end_of_storage);    \
+        self->m_impl.m_finish += n;                                            \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_append_n(name##_t *self,            \
+                                                    const T *src, size_t n) {  \
+        name##_iterator_t it = name##_reserve_back(self, n);                   \
+        memcpy(it, src, sizeof *it * n);                                       \
+        self->m_impl.m_finish += n;                                            \
+                                                                               \
+        return it;                                                             \
+    }                                                                          \
+                                                                               \
+    static inline void name##_pop_back(name##_t *self) {                       \
+        if (name##_empty(self) == false) {                                     \
+            --self->m_impl.m_finish;                                           \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_clear(name##_t *self) {                          \
+        self->m_impl.m_finish = self->m_impl.m_start;                          \
+    }                                                                          \
+                                                                               \
+    static inline void name##_foreach_range(name##_t *self,                    \
+                                            void (*func)(T *),                 \
+                                            name##_iterator_t beg,             \
+                                            name##_iterator_t end) {           \
+        (void)self;                                                            \
+        for (; beg < end; beg++) {                                             \
+            func(beg);                                                         \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static inline void name##_foreach(name##_t *self, void (*func)(T *)) {     \
+        name##_foreach_range(self, func, name##_begin(self), name##_end(self));\
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_find_range(name##_t *self,          \
+                                                      const T *valaddr,        \
+                                                      name##_iterator_t beg,   \
+                                                      name##_iterator_t end) { \
+        (void)self;                                                            \
+        for (; beg < end; beg++) {                                             \
+            if (cmp(beg, valaddr) == 0) {                                      \
+                return beg;                                                    \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline name##_iterator_t name##_find(name##_t *self,                \
+                                                const T *valaddr) {            \
+        return name##_find_range(self, valaddr, name##_begin(self),            \
+                                 name##_end(self));                            \
+    }                                                                          \
+                                                                               \
+    static inline int name##_search_range(name##_t *self, const T *valaddr,    \
+                                          name##_iterator_t beg,               \
+                                          name##_iterator_t end) {             \
+        name##_iterator_t it = name##_find_range(self, valaddr, beg, end);     \
+        return it ? (int)(it - self->m_impl.m_start) : -1;                     \
+    }                                                                          \
+                                                                               \
+    static inline int name##_search(name##_t *self, const T *valaddr) {        \
+        return name##_search_range(self, valaddr, name##_begin(self),          \
+                                   name##_end(self));                          \
+    }                                                                          \
+                                                                               \
+    static inline void name##_qsort_range(name##_t *self,                      \
+                                          name##_iterator_t pos,               \
+                                          name##_iterator_t end) {             \
+        (void)self;                                                            \
+        name##_sort_pdqsort(pos, end, NULL);                                   \
+    }                                                                          \
+                                                                               \
+    static inline void name##_qsort(name##_t *self) {                          \
+        name##_qsort_range(self, name##_begin(self), name##_end(self));        \
+    }                                                                          \
+                                                                               \
+    static inline void name##_mergesort_range(name##_t *self,                  \
+                                              name##_iterator_t pos,           \
+                                              name##_iterator_t end) {         \
+        const vector_allocator_t *a = self->m_impl.m_alloc;                    \
+        const size_t scratch_size = sizeof(T) * ((end - pos) / 2);             \
+        T *scratch = a->m_allocfn(a->m_ctx, scratch_size);                     \
+        assert(scratch || scratch_size == 0);                                  \
+                                                                               \
+        name##_sort_mergesort(pos, end, scratch, NULL);                        \
+        a->m_freefn(a->m_ctx, scratch, scratch_size);                          \
+    }                                                                          \
+                                                                               \
+    static inline void name##_mergesort(name##_t *self) {                      \
+        name##_mergesort_range(self, name##_begin(self), name##_end(self));    \
+    }                                                                          \
+                                                                               \
+    static inline void name##_heapsort_range(name##_t *self,                   \
+                                             name##_iterator_t pos,            \
+                                             name##_iterator_t end) {          \
+        (void)self;                                                            \
+        name##_sort_heapsort(pos, end, NULL);                                  \
+    }                                                                          \
+                                                                               \
+    static inline void name##_heapsort(name##_t *self) {                       \
+        name##_heapsort_range(self, name##_begin(self), name##_end(self));     \
+    }                                                                          \
+                                                                               \
+    static inline name##_t *name##_new(size_t capacity) {                      \
+        name##_t *v = NULL;                                                    \
+                                                                               \
+        if ((v = malloc(sizeof *v))) {                                         \
+            name##_init(v, capacity);                                          \
+        }                                                                      \
+                                                                               \
+        return v;                                                              \
+    }                                                                          \
+                                                                               \
+    static inline void name##_delete(name##_t *self) {                         \
+        name##_deinit(self);                                                   \
+        free(self);                                                            \
+    }
+
+#endif /* CGCS_VECTOR_TYPED_H */